@@ -12,7 +12,8 @@ class Morph(ConanFile):
         'volk/1.0.0@morph/dependencies',
         'gtest/1.8.1@bincrafters/stable',
         'sdl2/2.0.9@bincrafters/stable',
-        'TBB/2019_U4@conan/stable'
+        'TBB/2019_U4@conan/stable',
+        'zlib/1.2.11@conan/stable'
     )
 
     generators = {}
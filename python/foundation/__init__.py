@@ -0,0 +1 @@
+from _foundation import Histogram, TaskQueue, TaskQueueStatistics
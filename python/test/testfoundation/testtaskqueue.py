@@ -0,0 +1,48 @@
+import unittest
+
+import _foundation as foundation
+
+
+class TestTaskQueueStatistics(unittest.TestCase):
+
+    def setUp(self):
+        self.queue = foundation.TaskQueue()
+
+    def test_disabled_by_default(self):
+        self.queue.post(lambda: None)
+        self.queue.drain()
+
+        stats = self.queue.statistics()
+        self.assertEqual(0, stats.executed_count())
+        self.assertEqual(0, stats.wait_time().count())
+
+    def test_executed_tasks(self):
+        executed = []
+
+        self.queue.enable_statistics(True)
+
+        for i in range(10):
+            self.assertTrue(self.queue.post(lambda i=i: executed.append(i)))
+
+        self.queue.drain()
+
+        self.assertEqual(list(range(10)), executed)
+
+        stats = self.queue.statistics()
+        self.assertEqual(10, stats.executed_count())
+        self.assertEqual(0, stats.depth())
+        self.assertGreaterEqual(stats.max_depth(), 1)
+        self.assertEqual(10, stats.wait_time().count())
+        self.assertEqual(10, stats.execution_time().count())
+        self.assertGreater(stats.tasks_per_second(), 0.0)
+
+    def test_reset(self):
+        self.queue.enable_statistics(True)
+        self.queue.post(lambda: None)
+        self.queue.drain()
+
+        self.queue.reset_statistics()
+
+        stats = self.queue.statistics()
+        self.assertEqual(0, stats.executed_count())
+        self.assertEqual(0, stats.execution_time().count())
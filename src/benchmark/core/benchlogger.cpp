@@ -0,0 +1,132 @@
+#include "core/logger.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+using namespace core;
+
+namespace
+{
+
+constexpr std::size_t records_count = 1000000;
+
+} // namespace
+
+// Log 1M records and wait until every subscriber has seen all of them.
+static void logger_log_records(benchmark::State& state)
+{
+    const auto subscribers_count = static_cast<std::size_t>(state.range(0));
+    const std::string message = "a log record of a typical length";
+
+    for (auto _ : state)
+    {
+        auto logger = Logger::create();
+
+        std::vector<std::size_t> seen(subscribers_count, 0u);
+        std::vector<Logger::Disposable> subscriptions;
+
+        for (std::size_t i = 0; i < subscribers_count; ++i)
+        {
+            subscriptions.push_back(logger->subscribe(
+                [&seen, i](const State& records)
+                {
+                    seen[i] += records.back().message.size();
+                }));
+        }
+
+        for (std::size_t i = 0; i < records_count; ++i)
+        {
+            logger->log(Severity::Info, message);
+        }
+
+        logger->flush();
+        benchmark::DoNotOptimize(seen.data());
+
+        state.PauseTiming();
+        for (auto& subscription : subscriptions)
+        {
+            subscription.dispose();
+        }
+        logger.reset();
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * records_count);
+}
+BENCHMARK(logger_log_records)
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(16)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+namespace
+{
+
+// Records logged between two flushes in the latency benchmarks,
+// small enough to fit into the per-thread buffer of logf().
+constexpr std::size_t latency_batch_size = 512;
+
+} // namespace
+
+// Caller side latency of log() with a message formatted by the caller.
+static void logger_log_latency(benchmark::State& state)
+{
+    auto logger = Logger::create();
+    int i = 0;
+
+    for (auto _ : state)
+    {
+        for (std::size_t j = 0; j < latency_batch_size; ++j, ++i)
+        {
+            logger->log(Severity::Info, "frame " + std::to_string(i) + " rendered in " + std::to_string(0.5 * i) + " ms");
+        }
+
+        state.PauseTiming();
+        logger->flush();
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * latency_batch_size);
+}
+BENCHMARK(logger_log_latency)->Unit(benchmark::kMicrosecond);
+
+// Caller side latency of logf(), formatting happens on the logger queue.
+static void logger_logf_latency(benchmark::State& state)
+{
+    auto logger = Logger::create();
+    int i = 0;
+
+    for (auto _ : state)
+    {
+        for (std::size_t j = 0; j < latency_batch_size; ++j, ++i)
+        {
+            logger->logf(Severity::Info, "frame %d rendered in %f ms", i, 0.5 * i);
+        }
+
+        state.PauseTiming();
+        logger->flush();
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * latency_batch_size);
+}
+BENCHMARK(logger_logf_latency)->Unit(benchmark::kMicrosecond);
+
+// Cost of a trace left in hot code when traces are disabled at runtime.
+static void logger_disabled_trace(benchmark::State& state)
+{
+    auto logger = Logger::create();
+    logger->set_min_severity(Severity::Info);
+    int i = 0;
+
+    for (auto _ : state)
+    {
+        MORPH_LOG_TRACE(logger, "node %d evaluated", ++i);
+        benchmark::DoNotOptimize(i);
+    }
+}
+BENCHMARK(logger_disabled_trace);
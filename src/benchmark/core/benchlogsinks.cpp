@@ -0,0 +1,83 @@
+#include "core/binarysink.h"
+#include "core/filesink.h"
+#include "core/logger.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+using namespace core;
+
+namespace
+{
+
+constexpr std::size_t records_count = 100000;
+
+const std::string directory = "/tmp";
+
+// Log records_count records through the sink and wait until they are written.
+void log_through_sink(benchmark::State& state, const std::shared_ptr<LogSink>& sink)
+{
+    const std::string message = "node /scene/geometry/mesh42 evaluated in 0.25 ms";
+
+    for (auto _ : state)
+    {
+        auto logger = Logger::create();
+        logger->add_sink(sink);
+
+        for (std::size_t i = 0; i < records_count; ++i)
+        {
+            logger->log(Severity::Info, message);
+        }
+
+        logger->flush();
+    }
+
+    state.SetItemsProcessed(state.iterations() * records_count);
+}
+
+} // namespace
+
+static void log_sink_file(benchmark::State& state)
+{
+    const auto path = directory + "/morph_bench_file_sink.log";
+    std::remove(path.c_str());
+
+    log_through_sink(state, std::make_shared<FileSink>(path));
+
+    std::remove(path.c_str());
+}
+BENCHMARK(log_sink_file)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void log_sink_rotating_file(benchmark::State& state)
+{
+    const auto path = directory + "/morph_bench_rotating_sink.log";
+
+    log_through_sink(state, std::make_shared<RotatingFileSink>(path, 1u << 20, 4u));
+
+    std::remove(path.c_str());
+    for (int i = 1; i < 4; ++i)
+    {
+        std::remove((path + "." + std::to_string(i)).c_str());
+    }
+}
+BENCHMARK(log_sink_rotating_file)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void log_sink_binary(benchmark::State& state)
+{
+    auto sink = std::make_shared<BinarySink>(directory, "morph_bench_binary_sink", 16u << 20);
+
+    log_through_sink(state, sink);
+
+    const auto segments = sink->segments();
+    sink.reset();
+
+    for (const auto& segment : segments)
+    {
+        std::remove(segment.c_str());
+    }
+}
+BENCHMARK(log_sink_binary)->Unit(benchmark::kMillisecond)->UseRealTime();
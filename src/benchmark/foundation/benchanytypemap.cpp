@@ -0,0 +1,189 @@
+#include "foundation/immutable/anytypemap.h"
+#include "foundation/sharedany.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace foundation;
+using namespace foundation::immutable;
+
+namespace
+{
+
+constexpr int attributes_count = 64;
+
+// Node attributes: mostly scalars, a few strings.
+AnyTypeMap<int> make_attributes()
+{
+    AnyTypeMap<int> attributes;
+
+    for (int i = 0; i < attributes_count; ++i)
+    {
+        if (i % 8 == 0)
+        {
+            attributes = attributes.set(i, std::string("attribute"));
+        }
+        else
+        {
+            attributes = attributes.set(i, static_cast<float>(i));
+        }
+    }
+
+    return attributes;
+}
+
+} // namespace
+
+static void any_type_map_set_scalar(benchmark::State& state)
+{
+    auto attributes = make_attributes();
+
+    for (auto _ : state)
+    {
+        for (int i = 1; i < attributes_count; i += 8)
+        {
+            attributes = attributes.set(i, static_cast<float>(i) + 0.5f);
+        }
+
+        benchmark::DoNotOptimize(attributes.size());
+    }
+
+    state.SetItemsProcessed(state.iterations() * attributes_count / 8);
+}
+BENCHMARK(any_type_map_set_scalar);
+
+static void any_type_map_set_string(benchmark::State& state)
+{
+    auto attributes = make_attributes();
+
+    for (auto _ : state)
+    {
+        for (int i = 0; i < attributes_count; i += 8)
+        {
+            attributes = attributes.set(i, std::string("attribute"));
+        }
+
+        benchmark::DoNotOptimize(attributes.size());
+    }
+
+    state.SetItemsProcessed(state.iterations() * attributes_count / 8);
+}
+BENCHMARK(any_type_map_set_string);
+
+static void any_type_map_getattr(benchmark::State& state)
+{
+    auto attributes = make_attributes();
+
+    for (auto _ : state)
+    {
+        float sum = 0.0f;
+
+        for (int i = 0; i < attributes_count; ++i)
+        {
+            if (auto value = attributes.getattr<float>(i))
+            {
+                sum += *value;
+            }
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * attributes_count);
+}
+BENCHMARK(any_type_map_getattr);
+
+static void any_type_map_find(benchmark::State& state)
+{
+    const auto attributes = make_attributes();
+
+    for (auto _ : state)
+    {
+        float sum = 0.0f;
+
+        for (int i = 0; i < attributes_count; ++i)
+        {
+            if (auto value = attributes.find<float>(i))
+            {
+                sum += *value;
+            }
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * attributes_count);
+}
+BENCHMARK(any_type_map_find);
+
+// Type checks of a hot attribute, the common case of node evaluation.
+static void shared_any_pure_is(benchmark::State& state)
+{
+    const auto attributes = make_attributes();
+    const SharedAny* value = attributes.get(1);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(value);
+        benchmark::DoNotOptimize(value->pure_is<float>());
+        benchmark::DoNotOptimize(value->pure_is<std::string>());
+    }
+
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(shared_any_pure_is);
+
+static void shared_any_get(benchmark::State& state)
+{
+    const auto attributes = make_attributes();
+
+    std::vector<const SharedAny*> values;
+    for (int i = 0; i < attributes_count; ++i)
+    {
+        values.push_back(attributes.get(i));
+    }
+
+    for (auto _ : state)
+    {
+        float sum = 0.0f;
+
+        for (const auto* value : values)
+        {
+            if (auto f = value->get<float>())
+            {
+                sum += *f;
+            }
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * attributes_count);
+}
+BENCHMARK(shared_any_get);
+
+static void shared_any_int_cast(benchmark::State& state)
+{
+    const SharedAny value(static_cast<std::int16_t>(42));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(*value.cast<long>());
+    }
+}
+BENCHMARK(shared_any_int_cast);
+
+static void shared_any_int_value(benchmark::State& state)
+{
+    const SharedAny value(static_cast<std::int16_t>(42));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(value.value<long>());
+    }
+}
+BENCHMARK(shared_any_int_value);
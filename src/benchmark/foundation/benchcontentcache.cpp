@@ -0,0 +1,66 @@
+#include "foundation/contentcache.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace foundation;
+
+namespace
+{
+
+constexpr std::size_t cached_count = 4096;
+
+std::unique_ptr<ContentCache> cache;
+
+std::vector<MurmurHash> make_keys()
+{
+    std::vector<MurmurHash> keys(cached_count);
+
+    for (std::size_t i = 0; i < keys.size(); ++i)
+    {
+        keys[i].append_value(i);
+    }
+
+    return keys;
+}
+
+} // namespace
+
+// Threads looking up cached results, with state.range(0) shards.
+static void content_cache_hits(benchmark::State& state)
+{
+    const auto keys = make_keys();
+
+    if (state.thread_index() == 0)
+    {
+        cache = std::make_unique<ContentCache>(cached_count, static_cast<std::size_t>(state.range(0)));
+
+        for (std::size_t i = 0; i < keys.size(); ++i)
+        {
+            cache->put(keys[i], static_cast<std::uint64_t>(i));
+        }
+    }
+
+    std::size_t i = static_cast<std::size_t>(state.thread_index()) * 97u;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(cache->get(keys[i++ % keys.size()]));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0)
+    {
+        cache.reset();
+    }
+}
+BENCHMARK(content_cache_hits)
+    ->Arg(1)
+    ->Arg(16)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
@@ -0,0 +1,107 @@
+#include "foundation/immutable/map.h"
+#include "foundation/murmurhash.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <vector>
+
+using namespace foundation;
+
+namespace
+{
+
+// What DefaultHasher would be if it mixed integers as well.
+struct MixingHash
+{
+    std::size_t operator()(std::uint64_t value) const noexcept
+    {
+        return static_cast<std::size_t>(fmix64(value));
+    }
+};
+
+} // namespace
+
+// Build a map of state.range(0) sequential ids.
+template <typename Hash>
+static void immutable_map_insert_sequential_ids(benchmark::State& state)
+{
+    const auto size = static_cast<std::uint64_t>(state.range(0));
+
+    for (auto _ : state)
+    {
+        immutable::Map<std::uint64_t, std::uint64_t, Hash> map;
+
+        for (std::uint64_t id = 0; id < size; ++id)
+        {
+            map = map.set(id, id);
+        }
+
+        benchmark::DoNotOptimize(map.size());
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK_TEMPLATE(immutable_map_insert_sequential_ids, std::hash<std::uint64_t>)
+    ->Range(1 << 10, 1 << 18);
+BENCHMARK_TEMPLATE(immutable_map_insert_sequential_ids, MixingHash)
+    ->Range(1 << 10, 1 << 18);
+
+namespace
+{
+
+// Ids with the low shift bits fixed, e.g. aligned addresses
+// or ids with a tag in the low bits, in random order.
+std::vector<std::uint64_t> make_ids(std::size_t size, int shift)
+{
+    std::vector<std::uint64_t> ids(size);
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        ids[i] = static_cast<std::uint64_t>(i) << shift;
+    }
+
+    std::shuffle(ids.begin(), ids.end(), std::mt19937_64 {42u});
+
+    return ids;
+}
+
+} // namespace
+
+// Look up every key of a map of state.range(0) ids shifted by state.range(1) bits.
+template <typename Hash>
+static void immutable_map_lookup_ids(benchmark::State& state)
+{
+    const auto ids = make_ids(
+        static_cast<std::size_t>(state.range(0)),
+        static_cast<int>(state.range(1)));
+
+    immutable::Map<std::uint64_t, std::uint64_t, Hash> map;
+
+    for (const auto id : ids)
+    {
+        map = map.set(id, id);
+    }
+
+    for (auto _ : state)
+    {
+        std::uint64_t sum = 0;
+
+        for (const auto id : ids)
+        {
+            sum += *map.get(id);
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * ids.size());
+}
+BENCHMARK_TEMPLATE(immutable_map_lookup_ids, std::hash<std::uint64_t>)
+    ->ArgsProduct({{1 << 12, 1 << 18}, {0, 12, 40}});
+BENCHMARK_TEMPLATE(immutable_map_lookup_ids, MixingHash)
+    ->ArgsProduct({{1 << 12, 1 << 18}, {0, 12, 40}});
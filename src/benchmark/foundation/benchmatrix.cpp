@@ -0,0 +1,406 @@
+#include "foundation/matrix.h"
+#include "foundation/quaternion.h"
+#include "foundation/vector.h"
+#include "foundation/vectorstream.h"
+
+#include <benchmark/benchmark.h>
+
+#include <Eigen/Dense>
+#include <Eigen/Geometry>
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+using namespace foundation;
+
+namespace
+{
+
+constexpr std::size_t matrices_count = 1 << 10;
+constexpr std::size_t points_count = 1 << 16;
+
+template <std::size_t Size = 4>
+std::vector<Matrix<Size, float>> make_matrices()
+{
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+    std::vector<Matrix<Size, float>> res;
+    res.reserve(matrices_count);
+
+    for (std::size_t i = 0; i < matrices_count; ++i)
+    {
+        // Diagonally dominant, thus invertible.
+        Matrix<Size, float> m;
+        for (std::size_t r = 0; r < Size; ++r)
+        {
+            for (std::size_t c = 0; c < Size; ++c)
+            {
+                m(r, c) = dist(rng) + (r == c ? 4.0f : 0.0f);
+            }
+        }
+        res.push_back(m);
+    }
+
+    return res;
+}
+
+template <std::size_t Size>
+std::vector<Eigen::Matrix<float, Size, Size>> to_eigen(const std::vector<Matrix<Size, float>>& matrices)
+{
+    std::vector<Eigen::Matrix<float, Size, Size>> res;
+    res.reserve(matrices.size());
+
+    for (const auto& m : matrices)
+    {
+        res.push_back(Eigen::Map<const Eigen::Matrix<float, Size, Size, Eigen::RowMajor>>(m.data()));
+    }
+
+    return res;
+}
+
+std::vector<Vector3f> make_points()
+{
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+
+    std::vector<Vector3f> res;
+    res.reserve(points_count);
+
+    for (std::size_t i = 0; i < points_count; ++i)
+    {
+        res.emplace_back(dist(rng), dist(rng), dist(rng));
+    }
+
+    return res;
+}
+
+std::vector<Quaternionf> make_quaternions()
+{
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+    std::vector<Quaternionf> res;
+    res.reserve(matrices_count);
+
+    for (std::size_t i = 0; i < matrices_count; ++i)
+    {
+        res.push_back(normalize(Quaternionf(dist(rng), dist(rng), dist(rng), dist(rng))));
+    }
+
+    return res;
+}
+
+std::vector<Eigen::Quaternionf> to_eigen(const std::vector<Quaternionf>& quaternions)
+{
+    std::vector<Eigen::Quaternionf> res;
+    res.reserve(quaternions.size());
+
+    for (const auto& q : quaternions)
+    {
+        res.emplace_back(q.w(), q.x(), q.y(), q.z());
+    }
+
+    return res;
+}
+
+Matrix4f make_transform()
+{
+    const auto rotation = Quaternionf::from_axis_angle(Vector3f(0.0f, 0.6f, 0.8f), 0.5f);
+    return make_affine(to_matrix(rotation), Vector3f(1.0f, 2.0f, 3.0f));
+}
+
+} // namespace
+
+static void matrix4_mult(benchmark::State& state)
+{
+    const auto matrices = make_matrices();
+    auto out = matrices;
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i + 1 < matrices.size(); ++i)
+        {
+            out[i] = matrices[i] * matrices[i + 1];
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * (matrices.size() - 1));
+}
+BENCHMARK(matrix4_mult);
+
+static void eigen_matrix4_mult(benchmark::State& state)
+{
+    const auto matrices = to_eigen(make_matrices());
+    auto out = matrices;
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i + 1 < matrices.size(); ++i)
+        {
+            out[i].noalias() = matrices[i] * matrices[i + 1];
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * (matrices.size() - 1));
+}
+BENCHMARK(eigen_matrix4_mult);
+
+static void matrix4_inverse(benchmark::State& state)
+{
+    const auto matrices = make_matrices();
+    auto out = matrices;
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < matrices.size(); ++i)
+        {
+            out[i] = inverse(matrices[i]);
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * matrices.size());
+}
+BENCHMARK(matrix4_inverse);
+
+static void eigen_matrix4_inverse(benchmark::State& state)
+{
+    const auto matrices = to_eigen(make_matrices());
+    auto out = matrices;
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < matrices.size(); ++i)
+        {
+            out[i] = matrices[i].inverse();
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * matrices.size());
+}
+BENCHMARK(eigen_matrix4_inverse);
+
+static void matrix3_mult(benchmark::State& state)
+{
+    const auto matrices = make_matrices<3>();
+    auto out = matrices;
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i + 1 < matrices.size(); ++i)
+        {
+            out[i] = matrices[i] * matrices[i + 1];
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * (matrices.size() - 1));
+}
+BENCHMARK(matrix3_mult);
+
+static void eigen_matrix3_mult(benchmark::State& state)
+{
+    const auto matrices = to_eigen(make_matrices<3>());
+    auto out = matrices;
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i + 1 < matrices.size(); ++i)
+        {
+            out[i].noalias() = matrices[i] * matrices[i + 1];
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * (matrices.size() - 1));
+}
+BENCHMARK(eigen_matrix3_mult);
+
+static void matrix3_inverse(benchmark::State& state)
+{
+    const auto matrices = make_matrices<3>();
+    auto out = matrices;
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < matrices.size(); ++i)
+        {
+            out[i] = inverse(matrices[i]);
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * matrices.size());
+}
+BENCHMARK(matrix3_inverse);
+
+static void eigen_matrix3_inverse(benchmark::State& state)
+{
+    const auto matrices = to_eigen(make_matrices<3>());
+    auto out = matrices;
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < matrices.size(); ++i)
+        {
+            out[i] = matrices[i].inverse();
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * matrices.size());
+}
+BENCHMARK(eigen_matrix3_inverse);
+
+static void matrix4_transform_points(benchmark::State& state)
+{
+    const auto m = make_transform();
+    const auto points = make_points();
+    auto out = points;
+
+    for (auto _ : state)
+    {
+        transform_points(m, points, out);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(matrix4_transform_points);
+
+static void matrix4_transform_point_stream(benchmark::State& state)
+{
+    const auto m = make_transform();
+    const VectorStream3f points(make_points());
+    VectorStream3f out(points.size());
+
+    for (auto _ : state)
+    {
+        transform_points(m, points, out);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(matrix4_transform_point_stream);
+
+static void eigen_matrix4_transform_points(benchmark::State& state)
+{
+    const Eigen::Affine3f m(to_eigen(std::vector<Matrix4f> {make_transform()}).front());
+
+    const auto points = make_points();
+    Eigen::Matrix3Xf in(3, points.size());
+
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        in.col(i) << points[i].x(), points[i].y(), points[i].z();
+    }
+
+    Eigen::Matrix3Xf out(3, points.size());
+
+    for (auto _ : state)
+    {
+        out.noalias() = m * in;
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(eigen_matrix4_transform_points);
+
+static void quaternion_mult(benchmark::State& state)
+{
+    const auto quaternions = make_quaternions();
+    auto out = quaternions;
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i + 1 < quaternions.size(); ++i)
+        {
+            out[i] = quaternions[i] * quaternions[i + 1];
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * (quaternions.size() - 1));
+}
+BENCHMARK(quaternion_mult);
+
+static void eigen_quaternion_mult(benchmark::State& state)
+{
+    const auto quaternions = to_eigen(make_quaternions());
+    auto out = quaternions;
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i + 1 < quaternions.size(); ++i)
+        {
+            out[i] = quaternions[i] * quaternions[i + 1];
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * (quaternions.size() - 1));
+}
+BENCHMARK(eigen_quaternion_mult);
+
+static void quaternion_rotate(benchmark::State& state)
+{
+    const auto q = make_quaternions().front();
+    const auto points = make_points();
+    auto out = points;
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < points.size(); ++i)
+        {
+            out[i] = rotate(q, points[i]);
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(quaternion_rotate);
+
+static void eigen_quaternion_rotate(benchmark::State& state)
+{
+    const auto q = to_eigen(make_quaternions()).front();
+
+    std::vector<Eigen::Vector3f> points;
+    for (const auto& p : make_points())
+    {
+        points.emplace_back(p.x(), p.y(), p.z());
+    }
+
+    auto out = points;
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < points.size(); ++i)
+        {
+            out[i] = q * points[i];
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(eigen_quaternion_rotate);
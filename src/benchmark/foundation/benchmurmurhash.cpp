@@ -0,0 +1,167 @@
+#include "foundation/murmurhash.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+using namespace foundation;
+
+namespace
+{
+
+constexpr std::size_t message_size = 4096;
+
+struct Record
+{
+    std::uint64_t   id;
+    std::uint32_t   kind;
+    std::uint16_t   flags;
+};
+
+} // namespace
+
+// Hash state.range(0) bytes with a single append.
+static void murmur_hash_one_shot(benchmark::State& state)
+{
+    const std::vector<unsigned char> message(static_cast<std::size_t>(state.range(0)), 'x');
+
+    for (auto _ : state)
+    {
+        MurmurHash hash;
+        hash.append(message.data(), message.size());
+
+        benchmark::DoNotOptimize(hash.as_64bit());
+    }
+
+    state.SetBytesProcessed(state.iterations() * message.size());
+}
+BENCHMARK(murmur_hash_one_shot)
+    ->Arg(16)
+    ->Arg(256)
+    ->Arg(message_size);
+
+// Hash the same message in appends of state.range(0) bytes.
+static void murmur_hash_chunks(benchmark::State& state)
+{
+    const std::vector<unsigned char> message(message_size, 'x');
+    const auto chunk_size = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state)
+    {
+        MurmurHash hash;
+
+        for (std::size_t i = 0; i < message.size(); i += chunk_size)
+        {
+            hash.append(message.data() + i, chunk_size);
+        }
+
+        benchmark::DoNotOptimize(hash.as_64bit());
+    }
+
+    state.SetBytesProcessed(state.iterations() * message.size());
+}
+BENCHMARK(murmur_hash_chunks)
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(8)
+    ->Arg(64);
+
+// Hash records field by field.
+static void murmur_hash_fields(benchmark::State& state)
+{
+    std::vector<Record> records(256);
+
+    for (std::size_t i = 0; i < records.size(); ++i)
+    {
+        records[i] = Record {i, static_cast<std::uint32_t>(i % 7), 0u};
+    }
+
+    for (auto _ : state)
+    {
+        MurmurHash hash;
+
+        for (const auto& record : records)
+        {
+            hash.append_value(record.id);
+            hash.append_value(record.kind);
+            hash.append_value(record.flags);
+        }
+
+        benchmark::DoNotOptimize(hash.as_64bit());
+    }
+
+    state.SetBytesProcessed(state.iterations() * records.size() * 14u);
+}
+BENCHMARK(murmur_hash_fields);
+
+namespace
+{
+
+constexpr std::size_t keys_count = 4096;
+
+std::vector<std::string_view> make_keys(const std::vector<char>& storage, std::size_t key_size)
+{
+    std::vector<std::string_view> keys;
+
+    for (std::size_t i = 0; i < keys_count; ++i)
+    {
+        keys.emplace_back(storage.data() + i * key_size, key_size);
+    }
+
+    return keys;
+}
+
+} // namespace
+
+// Hash 4096 keys of state.range(0) bytes one by one.
+static void murmur_hash_keys_scalar(benchmark::State& state)
+{
+    const auto key_size = static_cast<std::size_t>(state.range(0));
+    const std::vector<char> storage(keys_count * key_size, 'k');
+    const auto keys = make_keys(storage, key_size);
+
+    std::vector<std::size_t> hashes(keys.size());
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < keys.size(); ++i)
+        {
+            MurmurHash hash;
+            hash.append(keys[i].data(), keys[i].size());
+            hashes[i] = hash.as_64bit();
+        }
+
+        benchmark::DoNotOptimize(hashes.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(murmur_hash_keys_scalar)
+    ->Arg(8)
+    ->Arg(32)
+    ->Arg(256);
+
+// Hash the same keys with murmur_hash_batch().
+static void murmur_hash_keys_batch(benchmark::State& state)
+{
+    const auto key_size = static_cast<std::size_t>(state.range(0));
+    const std::vector<char> storage(keys_count * key_size, 'k');
+    const auto keys = make_keys(storage, key_size);
+
+    std::vector<std::size_t> hashes(keys.size());
+
+    for (auto _ : state)
+    {
+        murmur_hash_batch(keys.data(), keys.size(), hashes.data());
+        benchmark::DoNotOptimize(hashes.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(murmur_hash_keys_batch)
+    ->Arg(8)
+    ->Arg(32)
+    ->Arg(256);
@@ -0,0 +1,107 @@
+#include "foundation/observable.h"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace foundation;
+
+namespace
+{
+
+class Counter : public Observable<int>
+{
+  public:
+    void set(int value)
+    {
+        notify(value);
+    }
+};
+
+class Batch : public Observable<std::vector<std::string>>
+{
+  public:
+    void set(const std::vector<std::string>& value)
+    {
+        notify(value);
+    }
+};
+
+std::shared_ptr<Counter> counter;
+
+constexpr std::size_t subscribers_count = 8;
+
+} // namespace
+
+// Every thread but the first notifies while the first one keeps
+// subscribing and unsubscribing.
+static void observable_notify_under_contention(benchmark::State& state)
+{
+    if (state.thread_index() == 0)
+    {
+        counter = std::make_shared<Counter>();
+
+        for (std::size_t i = 0; i < subscribers_count; ++i)
+        {
+            counter->subscribe([](int value) { benchmark::DoNotOptimize(value); });
+        }
+    }
+
+    int value = 0;
+
+    for (auto _ : state)
+    {
+        if (state.thread_index() == 0 && state.threads() > 1)
+        {
+            auto subscription = counter->subscribe([](int value) { benchmark::DoNotOptimize(value); });
+            subscription.dispose();
+        }
+        else
+        {
+            counter->set(++value);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0)
+    {
+        counter.reset();
+    }
+}
+BENCHMARK(observable_notify_under_contention)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+// Notify subscribers with an argument that is expensive to copy.
+static void observable_notify_large_argument(benchmark::State& state)
+{
+    auto batch = std::make_shared<Batch>();
+
+    const auto subscribers = static_cast<std::size_t>(state.range(0));
+
+    for (std::size_t i = 0; i < subscribers; ++i)
+    {
+        batch->subscribe(
+            [](const std::vector<std::string>& value)
+            {
+                benchmark::DoNotOptimize(value.data());
+            });
+    }
+
+    const std::vector<std::string> value(256, "a log record of a typical length");
+
+    for (auto _ : state)
+    {
+        batch->set(value);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(observable_notify_large_argument)
+    ->Arg(1)
+    ->Arg(8);
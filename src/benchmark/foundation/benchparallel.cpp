@@ -0,0 +1,143 @@
+#include "foundation/parallel.h"
+#include "foundation/vector.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <functional>
+#include <random>
+#include <vector>
+
+using namespace foundation;
+
+namespace
+{
+
+std::vector<Vector3f> make_points(std::size_t n)
+{
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+
+    std::vector<Vector3f> res;
+    res.reserve(n);
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        res.emplace_back(dist(rng), dist(rng), dist(rng));
+    }
+
+    return res;
+}
+
+// Translate, scale and twist a point around the z axis.
+Vector3f transform(const Vector3f& p)
+{
+    const Vector3f offset(1.0f, 2.0f, 3.0f);
+    const Vector3f axis(0.0f, 0.0f, 1.0f);
+
+    auto moved = (p + offset) * 0.5f;
+    return moved + cross_product(axis, moved) * 0.1f;
+}
+
+} // namespace
+
+static void vector3_transform_serial(benchmark::State& state)
+{
+    auto points = make_points(static_cast<std::size_t>(state.range(0)));
+    auto out = points;
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < points.size(); ++i)
+        {
+            out[i] = transform(points[i]);
+        }
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(vector3_transform_serial)->Arg(1 << 16)->Arg(1 << 20)->UseRealTime();
+
+static void vector3_transform_parallel_for(benchmark::State& state)
+{
+    auto points = make_points(static_cast<std::size_t>(state.range(0)));
+    auto out = points;
+
+    for (auto _ : state)
+    {
+        parallel_for(
+            std::size_t(0),
+            points.size(),
+            [&](std::size_t i)
+            {
+                out[i] = transform(points[i]);
+            },
+            static_cast<std::size_t>(state.range(1)));
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(vector3_transform_parallel_for)
+    ->Args({1 << 16, 0})
+    ->Args({1 << 20, 0})
+    ->Args({1 << 20, 4096})
+    ->UseRealTime();
+
+static void vector3_dot_reduce(benchmark::State& state)
+{
+    auto points = make_points(static_cast<std::size_t>(state.range(0)));
+    const auto order = state.range(1) != 0
+        ? ReductionOrder::Deterministic
+        : ReductionOrder::Any;
+
+    for (auto _ : state)
+    {
+        auto res = parallel_reduce(
+            std::size_t(0),
+            points.size(),
+            0.0f,
+            [&points](std::size_t b, std::size_t e, float acc)
+            {
+                for (auto i = b; i != e; ++i)
+                {
+                    acc += dot_product(points[i], points[i]);
+                }
+                return acc;
+            },
+            std::plus<float>(),
+            0u,
+            order);
+
+        benchmark::DoNotOptimize(res);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(vector3_dot_reduce)->Args({1 << 20, 0})->Args({1 << 20, 1})->UseRealTime();
+
+static void vector3_sort_by_length(benchmark::State& state)
+{
+    const auto points = make_points(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto sorted = points;
+        state.ResumeTiming();
+
+        parallel_sort(
+            sorted.begin(),
+            sorted.end(),
+            [](const Vector3f& lhs, const Vector3f& rhs)
+            {
+                return dot_product(lhs, lhs) < dot_product(rhs, rhs);
+            });
+
+        benchmark::DoNotOptimize(sorted.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(vector3_sort_by_length)->Arg(1 << 18)->UseRealTime();
@@ -0,0 +1,119 @@
+#include "foundation/taskgraph.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace foundation;
+
+namespace
+{
+
+constexpr std::size_t nodes_count = 10000;
+
+// Emulates evaluation of a cheap node.
+void node_workload()
+{
+    std::uint64_t x = 0x9e3779b97f4a7c15;
+    for (auto i = 0; i < 2000; ++i)
+    {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+    }
+    benchmark::DoNotOptimize(x);
+}
+
+// Random DAG where every node depends on up to 3 of the preceding 64 nodes.
+void build_graph(TaskGraph& graph, std::vector<std::vector<TaskGraph::NodeId>>* dependencies)
+{
+    std::mt19937 rng(42);
+
+    for (std::size_t i = 0; i < nodes_count; ++i)
+    {
+        auto node = graph.add_node(&node_workload);
+
+        std::vector<TaskGraph::NodeId> deps;
+        if (node != 0)
+        {
+            std::uniform_int_distribution<std::size_t> window(node > 64 ? node - 64 : 0, node - 1);
+            std::uniform_int_distribution<int> count(0, 3);
+
+            for (auto d = count(rng); d > 0; --d)
+            {
+                auto dep = window(rng);
+                graph.add_dependency(node, dep);
+                deps.push_back(dep);
+            }
+        }
+
+        if (dependencies)
+        {
+            dependencies->push_back(std::move(deps));
+        }
+    }
+}
+
+} // namespace
+
+static void task_graph_serial_baseline(benchmark::State& state)
+{
+    TaskGraph graph;
+    std::vector<std::vector<TaskGraph::NodeId>> dependencies;
+    build_graph(graph, &dependencies);
+
+    for (auto _ : state)
+    {
+        // Nodes are created in topological order.
+        for (std::size_t i = 0; i < nodes_count; ++i)
+        {
+            node_workload();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * nodes_count);
+}
+BENCHMARK(task_graph_serial_baseline)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void task_graph_full_execution(benchmark::State& state)
+{
+    TaskGraph graph;
+    build_graph(graph, nullptr);
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < nodes_count; ++i)
+        {
+            graph.mark_dirty(i);
+        }
+
+        graph.execute();
+    }
+
+    state.SetItemsProcessed(state.iterations() * nodes_count);
+}
+BENCHMARK(task_graph_full_execution)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void task_graph_incremental_execution(benchmark::State& state)
+{
+    TaskGraph graph;
+    build_graph(graph, nullptr);
+    graph.execute();
+
+    // Edit a node close to the end of the graph.
+    const auto edited = nodes_count - static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state)
+    {
+        graph.mark_dirty(edited);
+        graph.execute();
+    }
+}
+BENCHMARK(task_graph_incremental_execution)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
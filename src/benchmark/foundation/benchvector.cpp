@@ -0,0 +1,202 @@
+#include "foundation/vector.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+using namespace foundation;
+
+namespace
+{
+
+constexpr std::size_t points_count = 1 << 16;
+
+// The generic templates, called with explicit template arguments.
+struct Generic
+{
+    template <std::size_t D>
+    static Vector<D, float> add(const Vector<D, float>& a, const Vector<D, float>& b)
+    {
+        return operator+<D, float>(a, b);
+    }
+
+    template <std::size_t D>
+    static Vector<D, float> scale(const Vector<D, float>& a, float s)
+    {
+        return operator*<D, float>(a, s);
+    }
+
+    template <std::size_t D>
+    static float dot(const Vector<D, float>& a, const Vector<D, float>& b)
+    {
+        return dot_product<D, float>(a, b);
+    }
+
+    static Vector3f cross(const Vector3f& a, const Vector3f& b)
+    {
+        return cross_product<float>(a, b);
+    }
+};
+
+// Whatever overload resolution picks, SSE backed where available.
+struct Specialized
+{
+    template <std::size_t D>
+    static Vector<D, float> add(const Vector<D, float>& a, const Vector<D, float>& b)
+    {
+        return a + b;
+    }
+
+    template <std::size_t D>
+    static Vector<D, float> scale(const Vector<D, float>& a, float s)
+    {
+        return a * s;
+    }
+
+    template <std::size_t D>
+    static float dot(const Vector<D, float>& a, const Vector<D, float>& b)
+    {
+        return dot_product(a, b);
+    }
+
+    static Vector3f cross(const Vector3f& a, const Vector3f& b)
+    {
+        return cross_product(a, b);
+    }
+};
+
+template <typename V>
+std::vector<V> make_points()
+{
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+
+    std::vector<V> res;
+    res.reserve(points_count);
+
+    for (std::size_t i = 0; i < points_count; ++i)
+    {
+        if constexpr (V::dimensions == 3)
+        {
+            res.emplace_back(dist(rng), dist(rng), dist(rng));
+        }
+        else
+        {
+            res.emplace_back(dist(rng), dist(rng), dist(rng), 1.0f);
+        }
+    }
+
+    return res;
+}
+
+} // namespace
+
+// Translate, scale and twist points around the z axis.
+template <typename Ops>
+static void vector3_transform(benchmark::State& state)
+{
+    const auto points = make_points<Vector3f>();
+    auto out = points;
+
+    const Vector3f offset(1.0f, 2.0f, 3.0f);
+    const Vector3f axis(0.0f, 0.0f, 1.0f);
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < points.size(); ++i)
+        {
+            const auto moved = Ops::scale(Ops::add(points[i], offset), 0.5f);
+            out[i] = Ops::add(moved, Ops::scale(Ops::cross(axis, moved), 0.1f));
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK_TEMPLATE(vector3_transform, Generic);
+BENCHMARK_TEMPLATE(vector3_transform, Specialized);
+
+// Diffuse lighting of points with normals.
+template <typename Ops, typename V>
+static void vector_lighting(benchmark::State& state)
+{
+    const auto normals = make_points<V>();
+    const auto light = Ops::scale(normals.front(), 0.01f);
+
+    for (auto _ : state)
+    {
+        float sum = 0.0f;
+
+        for (const auto& normal : normals)
+        {
+            sum += std::max(Ops::dot(normal, light), 0.0f);
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * normals.size());
+}
+BENCHMARK_TEMPLATE(vector_lighting, Generic, Vector3f);
+BENCHMARK_TEMPLATE(vector_lighting, Specialized, Vector3f);
+BENCHMARK_TEMPLATE(vector_lighting, Generic, Vector4f);
+BENCHMARK_TEMPLATE(vector_lighting, Specialized, Vector4f);
+
+// Translate and scale homogeneous points.
+template <typename Ops>
+static void vector4_transform(benchmark::State& state)
+{
+    const auto points = make_points<Vector4f>();
+    auto out = points;
+
+    const Vector4f offset(1.0f, 2.0f, 3.0f, 0.0f);
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < points.size(); ++i)
+        {
+            out[i] = Ops::add(Ops::scale(Ops::add(points[i], offset), 0.5f), offset);
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK_TEMPLATE(vector4_transform, Generic);
+BENCHMARK_TEMPLATE(vector4_transform, Specialized);
+
+// Integrate positions, chained operators vs fused multiply_add.
+template <typename V, bool Fused>
+static void vector_multiply_add(benchmark::State& state)
+{
+    const auto velocities = make_points<V>();
+    auto positions = velocities;
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < positions.size(); ++i)
+        {
+            if constexpr (Fused)
+            {
+                positions[i] = multiply_add(velocities[i], 0.01f, positions[i]);
+            }
+            else
+            {
+                positions[i] = positions[i] + velocities[i] * 0.01f;
+            }
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * positions.size());
+}
+BENCHMARK_TEMPLATE(vector_multiply_add, Vector3f, false);
+BENCHMARK_TEMPLATE(vector_multiply_add, Vector3f, true);
+BENCHMARK_TEMPLATE(vector_multiply_add, Vector4f, false);
+BENCHMARK_TEMPLATE(vector_multiply_add, Vector4f, true);
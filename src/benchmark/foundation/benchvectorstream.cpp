@@ -0,0 +1,221 @@
+#include "foundation/vector.h"
+#include "foundation/vectorstream.h"
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+using namespace foundation;
+
+namespace
+{
+
+constexpr std::size_t points_count = 1 << 16;
+
+std::vector<Vector3f> make_points(unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+
+    std::vector<Vector3f> res;
+    res.reserve(points_count);
+
+    for (std::size_t i = 0; i < points_count; ++i)
+    {
+        res.emplace_back(dist(rng), dist(rng), dist(rng));
+    }
+
+    return res;
+}
+
+const std::array<Vector3f, 3> rotation {
+    Vector3f(0.8f, -0.6f, 0.0f),
+    Vector3f(0.6f, 0.8f, 0.0f),
+    Vector3f(0.0f, 0.0f, 1.0f)};
+
+const Vector3f translation(1.0f, 2.0f, 3.0f);
+
+} // namespace
+
+static void vector_add(benchmark::State& state)
+{
+    const auto a = make_points(1);
+    const auto b = make_points(2);
+    auto out = a;
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < a.size(); ++i)
+        {
+            out[i] = a[i] + b[i];
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * a.size());
+}
+BENCHMARK(vector_add);
+
+static void vector_stream_add(benchmark::State& state)
+{
+    const VectorStream3f a(make_points(1));
+    const VectorStream3f b(make_points(2));
+    VectorStream3f out(a.size());
+
+    for (auto _ : state)
+    {
+        add(a, b, out);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * a.size());
+}
+BENCHMARK(vector_stream_add);
+
+static void vector_dot_product(benchmark::State& state)
+{
+    const auto a = make_points(1);
+    const auto b = make_points(2);
+    std::vector<float> out(a.size());
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < a.size(); ++i)
+        {
+            out[i] = dot_product(a[i], b[i]);
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * a.size());
+}
+BENCHMARK(vector_dot_product);
+
+static void vector_stream_dot_product(benchmark::State& state)
+{
+    const VectorStream3f a(make_points(1));
+    const VectorStream3f b(make_points(2));
+    std::vector<float> out(a.size());
+
+    for (auto _ : state)
+    {
+        dot_product(a, b, out);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * a.size());
+}
+BENCHMARK(vector_stream_dot_product);
+
+static void vector_cross_product(benchmark::State& state)
+{
+    const auto a = make_points(1);
+    const auto b = make_points(2);
+    auto out = a;
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < a.size(); ++i)
+        {
+            out[i] = cross_product(a[i], b[i]);
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * a.size());
+}
+BENCHMARK(vector_cross_product);
+
+static void vector_stream_cross_product(benchmark::State& state)
+{
+    const VectorStream3f a(make_points(1));
+    const VectorStream3f b(make_points(2));
+    VectorStream3f out(a.size());
+
+    for (auto _ : state)
+    {
+        cross_product(a, b, out);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * a.size());
+}
+BENCHMARK(vector_stream_cross_product);
+
+static void vector_normalize(benchmark::State& state)
+{
+    const auto a = make_points(1);
+    auto out = a;
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < a.size(); ++i)
+        {
+            out[i] = a[i] * (1.0f / std::sqrt(dot_product(a[i], a[i])));
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * a.size());
+}
+BENCHMARK(vector_normalize);
+
+static void vector_stream_normalize(benchmark::State& state)
+{
+    const VectorStream3f a(make_points(1));
+    VectorStream3f out(a.size());
+
+    for (auto _ : state)
+    {
+        normalize(a, out);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * a.size());
+}
+BENCHMARK(vector_stream_normalize);
+
+static void vector_transform(benchmark::State& state)
+{
+    const auto a = make_points(1);
+    auto out = a;
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < a.size(); ++i)
+        {
+            out[i] = Vector3f(
+                dot_product(rotation[0], a[i]),
+                dot_product(rotation[1], a[i]),
+                dot_product(rotation[2], a[i])) + translation;
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * a.size());
+}
+BENCHMARK(vector_transform);
+
+static void vector_stream_transform(benchmark::State& state)
+{
+    const VectorStream3f a(make_points(1));
+    VectorStream3f out(a.size());
+
+    for (auto _ : state)
+    {
+        transform(a, rotation, translation, out);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * a.size());
+}
+BENCHMARK(vector_stream_transform);
@@ -0,0 +1,198 @@
+#include "binarylogrecord.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+namespace core
+{
+namespace
+{
+
+using Type = BinaryLogRecord::ArgumentType;
+
+// Longest conversion specification kept, flags, width and precision included.
+constexpr std::size_t max_spec_size = 32;
+
+template <typename T>
+void append_formatted(std::string& out, const char* spec, T value)
+{
+    char buffer[128];
+    const int size = std::snprintf(buffer, sizeof(buffer), spec, value);
+
+    if (size < 0)
+    {
+        return;
+    }
+
+    if (static_cast<std::size_t>(size) < sizeof(buffer))
+    {
+        out.append(buffer, static_cast<std::size_t>(size));
+        return;
+    }
+
+    // Large width or precision.
+    const auto offset = out.size();
+    out.resize(offset + static_cast<std::size_t>(size) + 1u);
+    std::snprintf(&out[offset], static_cast<std::size_t>(size) + 1u, spec, value);
+    out.resize(offset + static_cast<std::size_t>(size));
+}
+
+long long as_int(const BinaryLogRecord& record, std::size_t i)
+{
+    switch (record.types[i])
+    {
+        case Type::Int:     return record.values[i].i;
+        case Type::UInt:    return static_cast<long long>(record.values[i].u);
+        case Type::Double:  return static_cast<long long>(record.values[i].d);
+        default:            return 0;
+    }
+}
+
+double as_double(const BinaryLogRecord& record, std::size_t i)
+{
+    switch (record.types[i])
+    {
+        case Type::Int:     return static_cast<double>(record.values[i].i);
+        case Type::UInt:    return static_cast<double>(record.values[i].u);
+        case Type::Double:  return record.values[i].d;
+        default:            return 0.0;
+    }
+}
+
+/**
+ *  Format a single argument, spec holds the conversion specification
+ *  without the length modifier and the conversion character.
+ */
+void append_argument(
+    std::string&            out,
+    std::string&            spec,
+    char                    conversion,
+    const BinaryLogRecord&  record,
+    std::size_t             i)
+{
+    switch (conversion)
+    {
+        case 'd':
+        case 'i':
+            spec += "lld";
+            append_formatted(out, spec.c_str(), as_int(record, i));
+            break;
+
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X':
+            spec += "ll";
+            spec += conversion;
+            append_formatted(out, spec.c_str(), static_cast<unsigned long long>(as_int(record, i)));
+            break;
+
+        case 'c':
+            spec += 'c';
+            append_formatted(out, spec.c_str(), static_cast<int>(as_int(record, i)));
+            break;
+
+        case 'e':
+        case 'E':
+        case 'f':
+        case 'F':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            spec += conversion;
+            append_formatted(out, spec.c_str(), as_double(record, i));
+            break;
+
+        case 's':
+            spec += 's';
+            if (record.types[i] == Type::String)
+            {
+                append_formatted(out, spec.c_str(), record.text + record.values[i].u);
+            }
+            else
+            {
+                out += "(not a string)";
+            }
+            break;
+
+        case 'p':
+            spec += 'p';
+            append_formatted(out, spec.c_str(), record.values[i].p);
+            break;
+
+        default:
+            out += "(unknown conversion)";
+            break;
+    }
+}
+
+} // namespace
+
+std::string format(const BinaryLogRecord& record)
+{
+    std::string out;
+    std::string spec;
+    std::size_t argument = 0u;
+
+    const char* p = record.format;
+
+    while (*p != '\0')
+    {
+        const char* percent = std::strchr(p, '%');
+
+        if (percent == nullptr)
+        {
+            out.append(p);
+            break;
+        }
+
+        out.append(p, percent);
+        p = percent + 1;
+
+        if (*p == '%')
+        {
+            out += '%';
+            ++p;
+            continue;
+        }
+
+        spec.assign(1u, '%');
+
+        while (*p != '\0' && std::strchr("-+ #0123456789.", *p) != nullptr)
+        {
+            if (spec.size() < max_spec_size)
+            {
+                spec += *p;
+            }
+            ++p;
+        }
+
+        while (*p != '\0' && std::strchr("hlLqjzt", *p) != nullptr)
+        {
+            ++p;
+        }
+
+        if (*p == '\0')
+        {
+            break;
+        }
+
+        const char conversion = *p++;
+
+        if (argument < record.arguments_count)
+        {
+            append_argument(out, spec, conversion, record, argument++);
+        }
+        else
+        {
+            out += "(missing argument)";
+        }
+    }
+
+    return out;
+}
+
+} // namespace core
@@ -0,0 +1,165 @@
+#pragma once
+
+#include "logrecord.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace core
+{
+
+/**
+ *  Log record captured without formatting: a printf-style format string
+ *  and the raw values of its arguments.
+ *
+ *  The format string is referenced, not copied, so it must have static
+ *  storage duration (a string literal). String arguments are copied into
+ *  a small inline buffer and truncated if they don't fit, null char
+ *  pointers are captured as "(null)".
+ */
+struct BinaryLogRecord
+{
+    static constexpr std::size_t max_arguments = 8;
+    static constexpr std::size_t text_capacity = 64;
+
+    enum class ArgumentType : std::uint8_t
+    {
+        Int,
+        UInt,
+        Double,
+        Pointer,
+
+        // Value is the offset of a null terminated string in text.
+        String
+    };
+
+    union ArgumentValue
+    {
+        long long           i;
+        unsigned long long  u;
+        double              d;
+        const void*         p;
+    };
+
+    const char*                             format;
+    std::chrono::system_clock::time_point   timestamp;
+    Severity                                severity;
+    std::uint8_t                            arguments_count;
+    std::uint8_t                            text_size;
+    ArgumentType                            types[max_arguments];
+    ArgumentValue                           values[max_arguments];
+    char                                    text[text_capacity];
+};
+
+namespace detail
+{
+
+inline void capture_string(BinaryLogRecord& record, std::string_view s) noexcept
+{
+    auto& value = record.values[record.arguments_count];
+    record.types[record.arguments_count] = BinaryLogRecord::ArgumentType::String;
+
+    const std::size_t available = BinaryLogRecord::text_capacity - record.text_size;
+
+    if (available == 0u)
+    {
+        // Point to the terminator of the previous string.
+        value.u = BinaryLogRecord::text_capacity - 1u;
+        return;
+    }
+
+    const auto size = std::min(s.size(), available - 1u);
+
+    std::memcpy(record.text + record.text_size, s.data(), size);
+    record.text[record.text_size + size] = '\0';
+
+    value.u = record.text_size;
+    record.text_size = static_cast<std::uint8_t>(record.text_size + size + 1u);
+}
+
+template <typename T>
+void capture_argument(BinaryLogRecord& record, const T& arg) noexcept
+{
+    using Type = BinaryLogRecord::ArgumentType;
+
+    auto& type = record.types[record.arguments_count];
+    auto& value = record.values[record.arguments_count];
+
+    if constexpr (std::is_convertible_v<const T&, std::string_view> && std::is_pointer_v<T>)
+    {
+        // Null strings are formatted the way glibc's printf does.
+        capture_string(record, arg ? std::string_view(arg) : std::string_view("(null)"));
+    }
+    else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+    {
+        capture_string(record, std::string_view(arg));
+    }
+    else if constexpr (std::is_enum_v<T>)
+    {
+        type = Type::Int;
+        value.i = static_cast<long long>(arg);
+    }
+    else if constexpr (std::is_floating_point_v<T>)
+    {
+        type = Type::Double;
+        value.d = static_cast<double>(arg);
+    }
+    else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+    {
+        type = Type::Int;
+        value.i = arg;
+    }
+    else if constexpr (std::is_integral_v<T>)
+    {
+        type = Type::UInt;
+        value.u = arg;
+    }
+    else if constexpr (std::is_pointer_v<T>)
+    {
+        type = Type::Pointer;
+        value.p = arg;
+    }
+    else
+    {
+        static_assert(
+            std::is_arithmetic_v<T>,
+            "Log arguments must be arithmetic types, enums, pointers or strings.");
+    }
+
+    ++record.arguments_count;
+}
+
+} // namespace detail
+
+/**
+ *  Fill the record with the format and the arguments.
+ *  The timestamp and the severity are left to the caller.
+ */
+template <typename... Args>
+void capture(BinaryLogRecord& record, const char* format, const Args&... args) noexcept
+{
+    static_assert(
+        sizeof...(Args) <= BinaryLogRecord::max_arguments,
+        "Too many log arguments.");
+
+    record.format = format;
+    record.arguments_count = 0u;
+    record.text_size = 0u;
+
+    (detail::capture_argument(record, args), ...);
+}
+
+/**
+ *  Format the record the way printf would.
+ *  Length modifiers in the format are ignored: values are formatted
+ *  with the type they were captured with.
+ */
+std::string format(const BinaryLogRecord& record);
+
+} // namespace core
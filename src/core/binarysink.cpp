@@ -0,0 +1,270 @@
+#include "binarysink.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace core
+{
+namespace
+{
+
+constexpr std::size_t header_size = 16u;
+
+std::system_error make_system_error(const std::string& what)
+{
+    return std::system_error(errno, std::generic_category(), what);
+}
+
+void write_header(char* out, const LogRecord& record)
+{
+    const auto size_tag = static_cast<std::uint32_t>(record.message.size() + 1u);
+    const auto severity = static_cast<std::uint32_t>(record.severity);
+    const auto us = static_cast<std::int64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            record.timestamp.time_since_epoch()).count());
+
+    std::memcpy(out, &size_tag, 4u);
+    std::memcpy(out + 4u, &severity, 4u);
+    std::memcpy(out + 8u, &us, 8u);
+}
+
+/**
+ *  Memory mapped file of a fixed size.
+ */
+class Segment
+{
+  public:
+    Segment(const std::string& path, std::size_t size)
+      : m_size(size)
+      , m_used(0u)
+    {
+        m_fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+        if (m_fd < 0)
+        {
+            throw make_system_error("Can't create log segment " + path);
+        }
+
+        if (::ftruncate(m_fd, static_cast<off_t>(m_size)) != 0)
+        {
+            const auto error = make_system_error("Can't resize log segment " + path);
+            ::close(m_fd);
+            throw error;
+        }
+
+        void* data = ::mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+
+        if (data == MAP_FAILED)
+        {
+            const auto error = make_system_error("Can't map log segment " + path);
+            ::close(m_fd);
+            throw error;
+        }
+
+        m_data = static_cast<char*>(data);
+    }
+
+    Segment(const Segment&) = delete;
+    Segment& operator=(const Segment&) = delete;
+
+    ~Segment()
+    {
+        ::munmap(m_data, m_size);
+
+        // Leave room for the end marker.
+        const auto final_size = std::min(m_used + header_size, m_size);
+        if (::ftruncate(m_fd, static_cast<off_t>(final_size)) != 0)
+        {
+            // The segment stays valid with its original size.
+        }
+
+        ::close(m_fd);
+    }
+
+    std::size_t available() const noexcept
+    {
+        return m_size - m_used;
+    }
+
+    void append(const LogRecord& record) noexcept
+    {
+        char* out = m_data + m_used;
+
+        write_header(out, record);
+        std::memcpy(out + header_size, record.message.data(), record.message.size());
+
+        m_used += header_size + record.message.size();
+    }
+
+    void flush() noexcept
+    {
+        ::msync(m_data, m_size, MS_ASYNC);
+    }
+
+  private:
+    int                 m_fd;
+    char*               m_data;
+    const std::size_t   m_size;
+    std::size_t         m_used;
+};
+
+} // namespace
+
+struct BinarySink::Impl
+{
+    std::string                 m_directory;
+    std::string                 m_prefix;
+    std::size_t                 m_segment_size;
+    std::vector<std::string>    m_segments;
+    std::unique_ptr<Segment>    m_segment;
+
+    /**
+     *  Finalize the current segment and start a new one,
+     *  large enough for a record of record_size bytes.
+     */
+    void next_segment(std::size_t record_size)
+    {
+        m_segment.reset();
+
+        auto path = m_directory + "/" + m_prefix + "-" + std::to_string(m_segments.size()) + ".bin";
+
+        // One more header for the end marker.
+        const auto size = std::max(m_segment_size, record_size + header_size);
+
+        m_segment = std::make_unique<Segment>(path, size);
+        m_segments.push_back(std::move(path));
+    }
+};
+
+BinarySink::BinarySink(std::string directory, std::string prefix, std::size_t segment_size)
+  : m_impl(new Impl{std::move(directory), std::move(prefix), segment_size, {}, nullptr})
+{
+    try
+    {
+        m_impl->next_segment(0u);
+    }
+    catch (...)
+    {
+        delete m_impl;
+        throw;
+    }
+}
+
+BinarySink::~BinarySink()
+{
+    delete m_impl;
+}
+
+void BinarySink::write(const Records& records)
+{
+    for (const auto& record : records)
+    {
+        const auto record_size = header_size + record.message.size();
+
+        // Keep room for the end marker.
+        if (m_impl->m_segment->available() < record_size + header_size)
+        {
+            m_impl->next_segment(record_size);
+        }
+
+        m_impl->m_segment->append(record);
+    }
+}
+
+void BinarySink::flush()
+{
+    m_impl->m_segment->flush();
+}
+
+std::vector<std::string> BinarySink::segments() const
+{
+    return m_impl->m_segments;
+}
+
+std::vector<LogRecord> BinarySink::read_segment(const std::string& path)
+{
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0)
+    {
+        throw make_system_error("Can't open log segment " + path);
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0)
+    {
+        const auto error = make_system_error("Can't read log segment " + path);
+        ::close(fd);
+        throw error;
+    }
+
+    std::vector<char> data(static_cast<std::size_t>(st.st_size));
+    std::size_t read_size = 0u;
+
+    while (read_size < data.size())
+    {
+        const auto n = ::read(fd, data.data() + read_size, data.size() - read_size);
+
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+
+        if (n <= 0)
+        {
+            break;
+        }
+
+        read_size += static_cast<std::size_t>(n);
+    }
+
+    ::close(fd);
+
+    std::vector<LogRecord> records;
+    std::size_t offset = 0u;
+
+    while (offset + header_size <= read_size)
+    {
+        std::uint32_t size_tag;
+        std::uint32_t severity;
+        std::int64_t us;
+
+        std::memcpy(&size_tag, data.data() + offset, 4u);
+        std::memcpy(&severity, data.data() + offset + 4u, 4u);
+        std::memcpy(&us, data.data() + offset + 8u, 8u);
+
+        if (size_tag == 0u || offset + header_size + size_tag - 1u > read_size)
+        {
+            break;
+        }
+
+        LogRecord record;
+
+        record.message.assign(data.data() + offset + header_size, size_tag - 1u);
+        record.severity = static_cast<Severity>(severity);
+        record.timestamp = std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                std::chrono::microseconds(us)));
+
+        records.push_back(std::move(record));
+        offset += header_size + size_tag - 1u;
+    }
+
+    return records;
+}
+
+} // namespace core
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "logsink.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace core
+{
+
+/**
+ *  Writes records in binary form into memory mapped segment files
+ *  <directory>/<prefix>-<index>.bin of segment_size bytes each.
+ *
+ *  Each record is a 16 bytes header (message size + 1, severity,
+ *  microseconds since epoch, native byte order) followed by the message.
+ *  A zero header marks the end of a segment, so segments stay readable
+ *  if the process dies before they are finalized.
+ */
+class BinarySink : public LogSink
+{
+  public:
+    /**
+     *  Throws std::system_error if a segment file can't be created.
+     */
+    BinarySink(std::string directory, std::string prefix, std::size_t segment_size);
+
+    BinarySink(const BinarySink&) = delete;
+    BinarySink& operator=(const BinarySink&) = delete;
+
+    ~BinarySink() override;
+
+    void write(const Records& records) override;
+    void flush() override;
+
+    /**
+     *  Paths of the segments written so far, oldest first.
+     */
+    std::vector<std::string> segments() const;
+
+    /**
+     *  Read back the records of a segment file.
+     *  Throws std::system_error if the file can't be read.
+     */
+    static std::vector<LogRecord> read_segment(const std::string& path);
+
+  private:
+    struct Impl;
+    Impl* m_impl;
+};
+
+} // namespace core
@@ -0,0 +1,305 @@
+#include "filesink.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace core
+{
+namespace
+{
+
+// Room for "<timestamp> <severity> ".
+constexpr std::size_t max_prefix_size = 48;
+
+struct Prefix
+{
+    char        data[max_prefix_size];
+    std::size_t size;
+};
+
+std::system_error make_system_error(const std::string& what)
+{
+    return std::system_error(errno, std::generic_category(), what);
+}
+
+/**
+ *  writev() the whole vector, retrying on partial writes.
+ */
+void write_all(int fd, iovec* iov, std::size_t count)
+{
+    while (count != 0u)
+    {
+        const auto written = ::writev(fd, iov, static_cast<int>(count));
+
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            throw make_system_error("Can't write log file");
+        }
+
+        auto remaining = static_cast<std::size_t>(written);
+
+        while (count != 0u && remaining >= iov->iov_len)
+        {
+            remaining -= iov->iov_len;
+            ++iov;
+            --count;
+        }
+
+        if (count != 0u)
+        {
+            iov->iov_base = static_cast<char*>(iov->iov_base) + remaining;
+            iov->iov_len -= remaining;
+        }
+    }
+}
+
+Prefix format_prefix(const LogRecord& record) noexcept
+{
+    Prefix prefix;
+
+    const auto us = std::chrono::duration_cast<std::chrono::microseconds>(
+        record.timestamp.time_since_epoch()).count();
+
+    const int size = std::snprintf(
+        prefix.data,
+        sizeof(prefix.data),
+        "%lld %s ",
+        static_cast<long long>(us),
+        severity_name(record.severity));
+
+    prefix.size = static_cast<std::size_t>(size);
+
+    return prefix;
+}
+
+} // namespace
+
+struct FileSink::Impl
+{
+    Impl(int fd, bool is_owned, std::size_t buffer_size)
+      : m_fd(fd)
+      , m_is_owned(is_owned)
+      , m_size(0u)
+      , m_buffer_size(buffer_size)
+    {
+        struct stat st;
+
+        if (::fstat(m_fd, &st) == 0 && S_ISREG(st.st_mode))
+        {
+            m_size = static_cast<std::size_t>(st.st_size);
+        }
+
+        m_buffer.reserve(m_buffer_size);
+    }
+
+    ~Impl()
+    {
+        if (m_is_owned)
+        {
+            ::close(m_fd);
+        }
+    }
+
+    /**
+     *  Write the buffer followed by the extra vectors, if any.
+     *  The buffer is emptied even if this throws.
+     */
+    void write_buffer(iovec* extra = nullptr, std::size_t extra_count = 0u)
+    {
+        iovec iov[4];
+        std::size_t count = 0u;
+
+        if (!m_buffer.empty())
+        {
+            iov[count++] = iovec{m_buffer.data(), m_buffer.size()};
+        }
+
+        for (std::size_t i = 0; i < extra_count; ++i)
+        {
+            iov[count++] = extra[i];
+        }
+
+        try
+        {
+            write_all(m_fd, iov, count);
+        }
+        catch (...)
+        {
+            m_buffer.clear();
+            throw;
+        }
+
+        m_buffer.clear();
+    }
+
+    void append(const char* data, std::size_t size)
+    {
+        m_buffer.insert(m_buffer.end(), data, data + size);
+    }
+
+    const int           m_fd;
+    const bool          m_is_owned;
+    std::size_t         m_size;
+
+    const std::size_t   m_buffer_size;
+    std::vector<char>   m_buffer;
+};
+
+FileSink::FileSink(const std::string& path, std::size_t buffer_size)
+{
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+
+    if (fd < 0)
+    {
+        throw make_system_error("Can't open log file " + path);
+    }
+
+    m_impl = new Impl(fd, true, buffer_size);
+}
+
+FileSink::FileSink(int fd, std::size_t buffer_size)
+  : m_impl(new Impl(fd, false, buffer_size))
+{}
+
+FileSink::~FileSink()
+{
+    try
+    {
+        m_impl->write_buffer();
+    }
+    catch (const std::system_error&)
+    {
+        // Nobody left to report to.
+    }
+
+    delete m_impl;
+}
+
+void FileSink::write(const Records& records)
+{
+    static char newline = '\n';
+
+    bool has_errors = false;
+
+    for (const auto& record : records)
+    {
+        auto prefix = format_prefix(record);
+        const auto size = prefix.size + record.message.size() + 1u;
+
+        m_impl->m_size += size;
+        has_errors = has_errors || record.severity >= Severity::Error;
+
+        if (m_impl->m_buffer.size() + size <= m_impl->m_buffer_size)
+        {
+            m_impl->append(prefix.data, prefix.size);
+            m_impl->append(record.message.data(), record.message.size());
+            m_impl->append(&newline, 1u);
+        }
+        else if (size <= m_impl->m_buffer_size)
+        {
+            m_impl->write_buffer();
+
+            m_impl->append(prefix.data, prefix.size);
+            m_impl->append(record.message.data(), record.message.size());
+            m_impl->append(&newline, 1u);
+        }
+        else
+        {
+            iovec line[] = {
+                iovec{prefix.data, prefix.size},
+                iovec{const_cast<char*>(record.message.data()), record.message.size()},
+                iovec{&newline, 1u}};
+
+            m_impl->write_buffer(line, 3u);
+        }
+    }
+
+    if (has_errors)
+    {
+        m_impl->write_buffer();
+    }
+}
+
+void FileSink::flush()
+{
+    m_impl->write_buffer();
+}
+
+std::size_t FileSink::size() const noexcept
+{
+    return m_impl->m_size;
+}
+
+RotatingFileSink::RotatingFileSink(
+    std::string path,
+    std::size_t max_file_size,
+    std::size_t max_files,
+    std::size_t buffer_size)
+  : m_path(std::move(path))
+  , m_max_file_size(max_file_size)
+  , m_max_files(max_files)
+  , m_buffer_size(buffer_size)
+  , m_file(std::make_unique<FileSink>(m_path, m_buffer_size))
+{}
+
+RotatingFileSink::~RotatingFileSink() = default;
+
+void RotatingFileSink::write(const Records& records)
+{
+    if (m_file->size() >= m_max_file_size)
+    {
+        rotate();
+    }
+
+    m_file->write(records);
+}
+
+void RotatingFileSink::flush()
+{
+    m_file->flush();
+}
+
+void RotatingFileSink::rotate()
+{
+    m_file->flush();
+
+    const auto rotated_path = [this](std::size_t i)
+    {
+        return i == 0u ? m_path : m_path + "." + std::to_string(i);
+    };
+
+    if (m_max_files > 1u)
+    {
+        std::remove(rotated_path(m_max_files - 1u).c_str());
+
+        for (auto i = m_max_files - 1u; i > 0u; --i)
+        {
+            std::rename(rotated_path(i - 1u).c_str(), rotated_path(i).c_str());
+        }
+    }
+    else
+    {
+        std::remove(m_path.c_str());
+    }
+
+    // The current file stays open (under its new name) if this throws.
+    m_file = std::make_unique<FileSink>(m_path, m_buffer_size);
+}
+
+} // namespace core
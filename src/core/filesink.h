@@ -0,0 +1,103 @@
+#pragma once
+
+#include "logsink.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace core
+{
+
+/**
+ *  Writes records as "<microseconds since epoch> <severity> <message>" lines.
+ *
+ *  Lines are accumulated in a buffer of buffer_size bytes, written out when
+ *  it is full, on flush() and when the sink is destroyed. A batch holding
+ *  a record of Severity::Error or above is written out right away, so that
+ *  errors reach the file even if the process dies shortly after. Records
+ *  too large for the buffer are not copied: they are written along with
+ *  the buffer by a single writev().
+ */
+class FileSink : public LogSink
+{
+  public:
+    static constexpr std::size_t default_buffer_size = 64u * 1024u;
+
+    /**
+     *  Append to the file at path, creating it if needed.
+     *  Throws std::system_error if the file can't be opened.
+     */
+    explicit FileSink(const std::string& path, std::size_t buffer_size = default_buffer_size);
+
+    /**
+     *  Write to an already open file descriptor, e.g. STDOUT_FILENO.
+     *  The descriptor is not closed by the sink.
+     */
+    explicit FileSink(int fd, std::size_t buffer_size = default_buffer_size);
+
+    FileSink(const FileSink&) = delete;
+    FileSink& operator=(const FileSink&) = delete;
+
+    /**
+     *  Writes out the buffer, errors are ignored.
+     */
+    ~FileSink() override;
+
+    /**
+     *  Throws std::system_error on write errors,
+     *  the buffered lines are dropped in that case.
+     */
+    void write(const Records& records) override;
+    void flush() override;
+
+    /**
+     *  Number of bytes in the file, including the ones written before
+     *  the sink was created and the ones still buffered.
+     */
+    std::size_t size() const noexcept;
+
+  private:
+    struct Impl;
+    Impl* m_impl;
+};
+
+/**
+ *  File sink keeping at most max_files files of roughly max_file_size bytes.
+ *
+ *  When the file at path grows past max_file_size it is renamed to path.1,
+ *  path.1 to path.2 and so on, the oldest file is deleted. Files are
+ *  rotated between batches, so a file may exceed the limit by one batch.
+ *  The buffer of the current file is written out before it is rotated.
+ */
+class RotatingFileSink : public LogSink
+{
+  public:
+    /**
+     *  Throws std::system_error if the file can't be opened.
+     */
+    RotatingFileSink(
+        std::string path,
+        std::size_t max_file_size,
+        std::size_t max_files,
+        std::size_t buffer_size = FileSink::default_buffer_size);
+
+    RotatingFileSink(const RotatingFileSink&) = delete;
+    RotatingFileSink& operator=(const RotatingFileSink&) = delete;
+
+    ~RotatingFileSink() override;
+
+    void write(const Records& records) override;
+    void flush() override;
+
+  private:
+    void rotate();
+
+    const std::string           m_path;
+    const std::size_t           m_max_file_size;
+    const std::size_t           m_max_files;
+    const std::size_t           m_buffer_size;
+    std::unique_ptr<FileSink>   m_file;
+};
+
+} // namespace core
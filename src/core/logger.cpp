@@ -1,33 +1,473 @@
 #include "logger.h"
 
-#include "foundation/taskqueue.h"
 #include "foundation/observable.h"
+#include "foundation/spscqueue.h"
+#include "foundation/taskqueue.h"
 
 #include <tbb/spin_mutex.h>
 
+#include <zlib.h>
+
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <mutex>
+#include <stdexcept>
 #include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 
 using namespace foundation;
 
 namespace core
 {
 
-struct Logger::Impl
+namespace
+{
+
+std::size_t record_size(const LogRecord& lr)
+{
+    return sizeof(LogRecord) + lr.message.size();
+}
+
+/**
+ *  Gzip compressed file evicted records are appended to.
+ */
+class SpillFile
 {
-    Impl()
-      : m_task_queue(TaskQueue::Priority::Low)
+  public:
+    explicit SpillFile(const std::string& path)
+      : m_file(gzopen(path.c_str(), "ab"))
+    {
+        if (m_file == nullptr)
+        {
+            throw std::runtime_error("Can't open log spill file " + path);
+        }
+    }
+
+    SpillFile(const SpillFile&) = delete;
+    SpillFile& operator=(const SpillFile&) = delete;
+
+    ~SpillFile()
+    {
+        gzclose(m_file);
+    }
+
+    void write(const LogRecord& lr)
+    {
+        using namespace std::chrono;
+
+        const auto us = duration_cast<microseconds>(lr.timestamp.time_since_epoch()).count();
+
+        m_line.clear();
+        m_line += std::to_string(us);
+        m_line += ' ';
+        m_line += severity_name(lr.severity);
+        m_line += ' ';
+        m_line += lr.message;
+        m_line += '\n';
+
+        gzwrite(m_file, m_line.data(), static_cast<unsigned>(m_line.size()));
+    }
+
+    void flush()
+    {
+        gzflush(m_file, Z_SYNC_FLUSH);
+    }
+
+  private:
+    gzFile      m_file;
+    std::string m_line;
+};
+
+/**
+ *  Binary records logged by a single thread, consumed on the logger queue.
+ */
+struct ThreadBuffer
+{
+    static constexpr std::size_t capacity = 1024u;
+
+    ThreadBuffer()
+      : m_records(capacity)
     {}
 
-    State           m_state;
-    TaskQueue       m_task_queue;
-    tbb::spin_mutex m_state_mutex;
+    SpscQueue<BinaryLogRecord>  m_records;
+
+    // Set when the producing thread exits, the buffer is removed once drained.
+    std::atomic<bool>           m_is_abandoned {false};
+
+    // Set when the logger is destroyed.
+    std::atomic<bool>           m_is_closed {false};
+};
+
+/**
+ *  Buffers of the calling thread, one per logger it has logged to.
+ */
+class ThreadBuffers
+{
+  public:
+    ~ThreadBuffers()
+    {
+        for (auto& entry : m_entries)
+        {
+            entry.m_buffer->m_is_abandoned.store(true, std::memory_order_release);
+        }
+    }
+
+    ThreadBuffer* find(std::uint64_t logger_id) const noexcept
+    {
+        for (const auto& entry : m_entries)
+        {
+            if (entry.m_logger_id == logger_id)
+            {
+                return entry.m_buffer.get();
+            }
+        }
+
+        return nullptr;
+    }
+
+    void add(std::uint64_t logger_id, std::shared_ptr<ThreadBuffer> buffer)
+    {
+        m_entries.erase(
+            std::remove_if(
+                m_entries.begin(),
+                m_entries.end(),
+                [](const Entry& entry)
+                {
+                    return entry.m_buffer->m_is_closed.load(std::memory_order_acquire);
+                }),
+            m_entries.end());
+
+        m_entries.push_back(Entry{logger_id, std::move(buffer)});
+    }
+
+  private:
+    struct Entry
+    {
+        std::uint64_t                   m_logger_id;
+        std::shared_ptr<ThreadBuffer>   m_buffer;
+    };
+
+    std::vector<Entry> m_entries;
 };
 
-Logger::Logger()
-  : m_impl(new Impl())
+thread_local ThreadBuffers thread_buffers;
+
+/**
+ *  Publishes batches of new records to the record subscribers.
+ */
+class RecordsObservable : public Observable<State>
+{
+  public:
+    using Observable<State>::notify;
+};
+
+// Loggers are identified by id rather than by address,
+// which may be reused by a logger created later.
+std::atomic<std::uint64_t> next_logger_id {0u};
+
+} // namespace
+
+struct Logger::Impl
+{
+    Impl(Logger& logger, RetentionPolicy retention)
+      : m_logger(logger)
+      , m_id(next_logger_id.fetch_add(1u, std::memory_order_relaxed))
+      , m_retention(std::move(retention))
+      , m_state_bytes(0u)
+      , m_records(std::make_shared<RecordsObservable>())
+      , m_unpublished_count(0u)
+      , m_is_publish_scheduled(false)
+      , m_task_queue(TaskQueue::Priority::Low)
+    {
+        if (!m_retention.spill_path.empty())
+        {
+            m_spill = std::make_unique<SpillFile>(m_retention.spill_path);
+        }
+    }
+
+    ~Impl()
+    {
+        std::lock_guard<std::mutex> lock(m_buffers_mutex);
+
+        for (auto& buffer : m_buffers)
+        {
+            buffer->m_is_closed.store(true, std::memory_order_release);
+        }
+    }
+
+    ThreadBuffer* register_thread()
+    {
+        auto buffer = std::make_shared<ThreadBuffer>();
+
+        {
+            std::lock_guard<std::mutex> lock(m_buffers_mutex);
+            m_buffers.push_back(buffer);
+        }
+
+        auto result = buffer.get();
+        thread_buffers.add(m_id, std::move(buffer));
+
+        return result;
+    }
+
+    void schedule_drain()
+    {
+        if (!m_is_drain_scheduled.exchange(true, std::memory_order_acq_rel))
+        {
+            m_task_queue.post([this]() { drain_thread_buffers(); });
+        }
+    }
+
+    /**
+     *  Format the records captured by logf() and publish them.
+     */
+    void drain_thread_buffers()
+    {
+        m_is_drain_scheduled.store(false, std::memory_order_relaxed);
+
+        // Pairs with the fence in post_binary_record(): either the producer
+        // sees the flag cleared and schedules another drain, or the record
+        // it has pushed is visible here.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        bool has_more = false;
+
+        {
+            std::lock_guard<std::mutex> lock(m_buffers_mutex);
+
+            for (auto it = m_buffers.begin(); it != m_buffers.end();)
+            {
+                auto& buffer = **it;
+                const bool is_abandoned = buffer.m_is_abandoned.load(std::memory_order_acquire);
+
+                // Bound the batch so that a busy producer can't starve the queue.
+                BinaryLogRecord record;
+                std::size_t popped = 0u;
+
+                while (popped < ThreadBuffer::capacity && buffer.m_records.try_pop(record))
+                {
+                    m_batch.push_back(record);
+                    ++popped;
+                }
+
+                if (popped == ThreadBuffer::capacity)
+                {
+                    has_more = true;
+                }
+
+                if (is_abandoned && buffer.m_records.empty())
+                {
+                    it = m_buffers.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        }
+
+        if (has_more)
+        {
+            schedule_drain();
+        }
+
+        if (m_batch.empty())
+        {
+            return;
+        }
+
+        std::stable_sort(
+            m_batch.begin(),
+            m_batch.end(),
+            [](const BinaryLogRecord& lhs, const BinaryLogRecord& rhs)
+            {
+                return lhs.timestamp < rhs.timestamp;
+            });
+
+        State state;
+
+        for (const auto& record : m_batch)
+        {
+            LogRecord lr;
+
+            lr.message = format(record);
+            lr.severity = record.severity;
+            lr.timestamp = record.timestamp;
+
+            state = append(std::move(lr));
+        }
+
+        m_batch.clear();
+        m_logger.notify(std::move(state));
+    }
+
+    bool exceeds_retention(std::size_t records, std::size_t bytes) const
+    {
+        return (m_retention.max_records != 0u && records > m_retention.max_records)
+            || (m_retention.max_bytes != 0u && bytes > m_retention.max_bytes);
+    }
+
+    /**
+     *  Append the record, evict the records exceeding the retention policy
+     *  and return the new state.
+     */
+    State append(LogRecord&& lr)
+    {
+        State state;
+        State previous;
+        std::size_t evicted_count = 0u;
+
+        {
+            tbb::spin_mutex::scoped_lock lock(m_state_mutex);
+
+            m_state = m_state.push_back(std::move(lr));
+            m_state_bytes += record_size(m_state.back());
+
+            while (evicted_count + 1u < m_state.size()
+                && exceeds_retention(m_state.size() - evicted_count, m_state_bytes))
+            {
+                m_state_bytes -= record_size(m_state[evicted_count]);
+                ++evicted_count;
+            }
+
+            if (evicted_count != 0u)
+            {
+                previous = m_state;
+                m_state = m_state.drop_front(evicted_count);
+            }
+
+            state = m_state;
+        }
+
+        if (m_spill)
+        {
+            for (std::size_t i = 0; i < evicted_count; ++i)
+            {
+                m_spill->write(previous[i]);
+            }
+        }
+
+        if (m_record_consumers_count.load(std::memory_order_relaxed) != 0u)
+        {
+            ++m_unpublished_count;
+
+            // Posted behind the records already queued, which get
+            // published by the same task.
+            if (!m_is_publish_scheduled)
+            {
+                m_is_publish_scheduled = true;
+                m_task_queue.post([this]() { publish_records(); });
+            }
+        }
+
+        return state;
+    }
+
+    /**
+     *  Notify record subscribers and write to the sinks
+     *  the records appended since the previous call.
+     */
+    void publish_records()
+    {
+        m_is_publish_scheduled = false;
+
+        if (m_unpublished_count == 0u)
+        {
+            return;
+        }
+
+        State state;
+
+        {
+            tbb::spin_mutex::scoped_lock lock(m_state_mutex);
+            state = m_state;
+        }
+
+        const auto count = std::min(m_unpublished_count, state.size());
+        m_unpublished_count = 0u;
+
+        auto records = state.drop_front(state.size() - count);
+
+        for (const auto& sink : sinks())
+        {
+            try
+            {
+                sink->write(records);
+            }
+            catch (const std::exception& ex)
+            {
+                on_sink_error(*sink, ex);
+            }
+        }
+
+        m_records->notify(std::move(records));
+    }
+
+    std::vector<std::shared_ptr<LogSink>> sinks()
+    {
+        std::lock_guard<std::mutex> lock(m_sinks_mutex);
+        return m_sinks;
+    }
+
+    void on_sink_error(LogSink& sink, const std::exception& error)
+    {
+        m_sink_errors_count.fetch_add(1u, std::memory_order_relaxed);
+
+        SinkErrorHandler handler;
+
+        {
+            std::lock_guard<std::mutex> lock(m_sinks_mutex);
+            handler = m_sink_error_handler;
+        }
+
+        if (handler)
+        {
+            handler(sink, error);
+        }
+    }
+
+    Logger&                                     m_logger;
+    const std::uint64_t                         m_id;
+
+    const RetentionPolicy                       m_retention;
+    std::unique_ptr<SpillFile>                  m_spill;
+    State                                       m_state;
+    std::size_t                                 m_state_bytes;
+    tbb::spin_mutex                             m_state_mutex;
+
+    std::shared_ptr<RecordsObservable>          m_records;
+    std::vector<std::shared_ptr<LogSink>>       m_sinks;
+    SinkErrorHandler                            m_sink_error_handler;
+    std::mutex                                  m_sinks_mutex;
+    std::atomic<std::uint64_t>                  m_sink_errors_count {0u};
+
+    // Record subscribers and sinks.
+    std::atomic<std::size_t>                    m_record_consumers_count {0u};
+
+    // Only accessed on the queue.
+    std::size_t                                 m_unpublished_count;
+    bool                                        m_is_publish_scheduled;
+
+    std::vector<std::shared_ptr<ThreadBuffer>>  m_buffers;
+    std::mutex                                  m_buffers_mutex;
+    std::atomic<bool>                           m_is_drain_scheduled {false};
+
+    // Only accessed on the queue.
+    std::vector<BinaryLogRecord>                m_batch;
+
+    // Destroyed first, tasks may still access the members above.
+    TaskQueue                                   m_task_queue;
+};
+
+Logger::Logger(RetentionPolicy retention)
+  : m_min_severity(Severity::Trace)
+  , m_impl(new Impl(*this, std::move(retention)))
 {}
 
 Logger::~Logger()
@@ -37,32 +477,157 @@ Logger::~Logger()
 
 std::shared_ptr<Logger> Logger::create() noexcept
 {
-    return std::shared_ptr<Logger>(new Logger());
+    return std::shared_ptr<Logger>(new Logger(RetentionPolicy()));
+}
+
+std::shared_ptr<Logger> Logger::create(RetentionPolicy retention)
+{
+    return std::shared_ptr<Logger>(new Logger(std::move(retention)));
 }
 
 void Logger::log(Severity severity, std::string message)
 {
+    if (!is_enabled(severity))
+    {
+        return;
+    }
+
     LogRecord lr;
 
     lr.severity = severity;
-    lr.message = message;
+    lr.message = std::move(message);
     lr.timestamp = std::chrono::system_clock::now();
 
     post_record_to_queue(std::move(lr));
 }
 
-void Logger::post_record_to_queue(LogRecord&& lr)
+Logger::Disposable Logger::subscribe_records(OnUpdateFn on_records)
+{
+    auto subscription = m_impl->m_records->subscribe(std::move(on_records));
+    m_impl->m_record_consumers_count.fetch_add(1u, std::memory_order_relaxed);
+
+    auto is_disposed = std::make_shared<std::atomic<bool>>(false);
+
+    return Disposable(
+        [thisWeakPtr = weak_from_this(), subscription, is_disposed]() mutable
+        {
+            if (is_disposed->exchange(true))
+            {
+                return;
+            }
+
+            subscription.dispose();
+
+            if (const auto thisPtr = thisWeakPtr.lock())
+            {
+                static_cast<Logger&>(*thisPtr).m_impl->m_record_consumers_count.fetch_sub(
+                    1u,
+                    std::memory_order_relaxed);
+            }
+        });
+}
+
+void Logger::add_sink(std::shared_ptr<LogSink> sink)
+{
+    std::lock_guard<std::mutex> lock(m_impl->m_sinks_mutex);
+
+    m_impl->m_sinks.push_back(std::move(sink));
+    m_impl->m_record_consumers_count.fetch_add(1u, std::memory_order_relaxed);
+}
+
+void Logger::remove_sink(const std::shared_ptr<LogSink>& sink)
+{
+    std::lock_guard<std::mutex> lock(m_impl->m_sinks_mutex);
+
+    auto& sinks = m_impl->m_sinks;
+    const auto it = std::find(sinks.begin(), sinks.end(), sink);
+
+    if (it != sinks.end())
+    {
+        sinks.erase(it);
+        m_impl->m_record_consumers_count.fetch_sub(1u, std::memory_order_relaxed);
+    }
+}
+
+void Logger::set_sink_error_handler(SinkErrorHandler handler)
+{
+    std::lock_guard<std::mutex> lock(m_impl->m_sinks_mutex);
+    m_impl->m_sink_error_handler = std::move(handler);
+}
+
+std::uint64_t Logger::sink_errors_count() const noexcept
+{
+    return m_impl->m_sink_errors_count.load(std::memory_order_relaxed);
+}
+
+void Logger::flush()
 {
-    m_impl->m_task_queue.post([=]()
+    m_impl->m_task_queue.post([this]() { m_impl->drain_thread_buffers(); });
+    m_impl->m_task_queue.post([this]()
     {
+        m_impl->publish_records();
+
+        for (const auto& sink : m_impl->sinks())
         {
-            tbb::spin_mutex::scoped_lock lock(m_impl->m_state_mutex);
-            m_impl->m_state.push_back(std::move(lr));
+            try
+            {
+                sink->flush();
+            }
+            catch (const std::exception& ex)
+            {
+                m_impl->on_sink_error(*sink, ex);
+            }
         }
+    });
+
+    if (m_impl->m_spill)
+    {
+        m_impl->m_task_queue.post([this]() { m_impl->m_spill->flush(); });
+    }
+
+    m_impl->m_task_queue.drain();
+}
+
+void Logger::enable_queue_statistics(bool enable)
+{
+    m_impl->m_task_queue.enable_statistics(enable);
+}
+
+TaskQueue::Statistics Logger::queue_statistics() const
+{
+    return m_impl->m_task_queue.statistics();
+}
 
-        // TODO: not synchronized access to m_state.
-        notify(m_impl->m_state);
+void Logger::post_record_to_queue(LogRecord&& lr)
+{
+    m_impl->m_task_queue.post([this, lr = std::move(lr)]() mutable
+    {
+        notify(m_impl->append(std::move(lr)));
     });
 }
 
+void Logger::post_binary_record(const BinaryLogRecord& record)
+{
+    auto buffer = thread_buffers.find(m_impl->m_id);
+
+    if (buffer == nullptr)
+    {
+        buffer = m_impl->register_thread();
+    }
+
+    // Backpressure, see logf().
+    while (!buffer->m_records.try_push(record))
+    {
+        m_impl->schedule_drain();
+        std::this_thread::yield();
+    }
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (!m_impl->m_is_drain_scheduled.load(std::memory_order_relaxed))
+    {
+        m_impl->schedule_drain();
+    }
+}
+
 } // namespace core
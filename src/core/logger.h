@@ -1,49 +1,201 @@
 #pragma once
 
+#include "binarylogrecord.h"
+#include "logrecord.h"
+#include "logsink.h"
+
+#include "foundation/immutable/vector.h"
 #include "foundation/observable.h"
+#include "foundation/taskqueue.h"
 
+#include <atomic>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
 #include <memory>
 #include <string>
-#include <vector>
+
+/**
+ *  Minimum severity compiled in by the MORPH_LOG_* macros,
+ *  as the numeric value of core::Severity. Set by the log_level build option.
+ */
+#ifndef MORPH_LOG_LEVEL
+#define MORPH_LOG_LEVEL 0
+#endif
 
 namespace core
 {
 
-enum class Severity
-{
-    Trace,
-    Debug,
-    Info,
-    Warning,
-    Error,
-    Fatal
-};
+/**
+ *  Log records shared between the snapshots handed to subscribers:
+ *  appending a record doesn't copy the previous ones.
+ */
+using State = foundation::immutable::Vector<LogRecord>;
 
-struct LogRecord
+/**
+ *  Limits on the records kept in the logger state, zero means no limit.
+ *  When a limit is exceeded the oldest records are evicted,
+ *  the most recent record is always kept.
+ */
+struct RetentionPolicy
 {
-    std::string                             message;
-    Severity                                severity;
-    std::chrono::system_clock::time_point   timestamp;
-};
+    std::size_t max_records = 0u;
+
+    // Approximate memory used by the records.
+    std::size_t max_bytes = 0u;
 
-using State = std::vector<LogRecord>;
+    // If not empty, evicted records are appended to this gzip compressed file,
+    // one "<microseconds since epoch> <severity> <message>" line per record.
+    std::string spill_path;
+};
 
 class Logger : public foundation::Observable<State>
 {
   public:
     static std::shared_ptr<Logger> create() noexcept;
+
+    /**
+     *  Throws std::runtime_error if the spill file can't be opened.
+     */
+    static std::shared_ptr<Logger> create(RetentionPolicy retention);
     ~Logger();
 
+    /**
+     *  Subscribe to the records appended since the previous notification
+     *  rather than to the whole state. Records appended while the logger
+     *  queue is backed up are coalesced into a single notification.
+     *  Records evicted by the retention policy before being delivered
+     *  are skipped.
+     */
+    Disposable subscribe_records(OnUpdateFn on_records);
+
+    /**
+     *  Feed the records to the sink from the logger queue, in batches
+     *  of the records appended since the previous write (see LogSink).
+     */
+    void add_sink(std::shared_ptr<LogSink> sink);
+    void remove_sink(const std::shared_ptr<LogSink>& sink);
+
+    /**
+     *  Called on the logger queue when a sink throws from write() or flush(),
+     *  the batch a write() failed for is lost for that sink only.
+     *  The handler must not throw.
+     */
+    using SinkErrorHandler = std::function<void(LogSink& sink, const std::exception& error)>;
+    void set_sink_error_handler(SinkErrorHandler handler);
+
+    /**
+     *  Number of write() and flush() calls that failed, on all sinks.
+     */
+    std::uint64_t sink_errors_count() const noexcept;
+
+    /**
+     *  Records less severe than the threshold are dropped by log() and logf()
+     *  before anything is allocated or posted. Defaults to Severity::Trace.
+     */
+    void set_min_severity(Severity severity) noexcept
+    {
+        m_min_severity.store(severity, std::memory_order_relaxed);
+    }
+
+    Severity min_severity() const noexcept
+    {
+        return m_min_severity.load(std::memory_order_relaxed);
+    }
+
+    bool is_enabled(Severity severity) const noexcept
+    {
+        return severity >= min_severity();
+    }
+
     void log(Severity severity, std::string message);
 
+    /**
+     *  Low latency alternative to log(): the record is captured in binary
+     *  form into a lock-free buffer owned by the calling thread, formatting
+     *  and delivery to subscribers happen on the logger queue. Subscribers
+     *  are notified once per batch of such records.
+     *
+     *  Records of a thread keep their order, records of different threads
+     *  are ordered by timestamp within a batch. See BinaryLogRecord for
+     *  the restrictions on the format and the arguments.
+     *
+     *  Records are never dropped: when the buffer of the calling thread is
+     *  full (1024 records the queue hasn't consumed yet), logf() yields
+     *  until the queue makes room, so a thread logging faster than the
+     *  queue formats is slowed down to its pace. For the same reason
+     *  subscribers must not log more than that many records with logf()
+     *  from a single notification.
+     */
+    template <typename... Args>
+    void logf(Severity severity, const char* format, const Args&... args)
+    {
+        if (!is_enabled(severity))
+        {
+            return;
+        }
+
+        BinaryLogRecord record;
+
+        capture(record, format, args...);
+        record.severity = severity;
+        record.timestamp = std::chrono::system_clock::now();
+
+        post_binary_record(record);
+    }
+
+    /**
+     *  Block until all the records logged so far are delivered to subscribers,
+     *  including record subscribers, and written to the sinks, and the records
+     *  evicted so far are written to the spill file.
+     */
+    void flush();
+
+    /**
+     *  Statistics of the queue log records are processed on.
+     */
+    void enable_queue_statistics(bool enable);
+    foundation::TaskQueue::Statistics queue_statistics() const;
+
   private:
-    Logger();
+    explicit Logger(RetentionPolicy retention);
 
     void post_record_to_queue(LogRecord&& lr);
+    void post_binary_record(const BinaryLogRecord& record);
+
+    std::atomic<Severity> m_min_severity;
 
     struct Impl;
     Impl* m_impl;
 };
 
 } // namespace core
+
+/**
+ *  Log through logf() unless the severity is below MORPH_LOG_LEVEL, in which
+ *  case the call is compiled out, or below the logger threshold, in which
+ *  case the arguments are not evaluated. logger is a pointer to core::Logger.
+ *
+ *      MORPH_LOG_DEBUG(logger, "evaluated %s in %f ms", node_name, time);
+ */
+#define MORPH_LOG(logger, severity, ...)                                        \
+    do                                                                          \
+    {                                                                           \
+        if constexpr (static_cast<int>(severity) >= MORPH_LOG_LEVEL)            \
+        {                                                                       \
+            auto&& morph_log_logger_ = (logger);                                \
+            if (morph_log_logger_->is_enabled(severity))                        \
+            {                                                                   \
+                morph_log_logger_->logf(severity, __VA_ARGS__);                 \
+            }                                                                   \
+        }                                                                       \
+    } while (false)
+
+#define MORPH_LOG_TRACE(logger, ...)   MORPH_LOG(logger, ::core::Severity::Trace, __VA_ARGS__)
+#define MORPH_LOG_DEBUG(logger, ...)   MORPH_LOG(logger, ::core::Severity::Debug, __VA_ARGS__)
+#define MORPH_LOG_INFO(logger, ...)    MORPH_LOG(logger, ::core::Severity::Info, __VA_ARGS__)
+#define MORPH_LOG_WARNING(logger, ...) MORPH_LOG(logger, ::core::Severity::Warning, __VA_ARGS__)
+#define MORPH_LOG_ERROR(logger, ...)   MORPH_LOG(logger, ::core::Severity::Error, __VA_ARGS__)
+#define MORPH_LOG_FATAL(logger, ...)   MORPH_LOG(logger, ::core::Severity::Fatal, __VA_ARGS__)
@@ -0,0 +1,21 @@
+#include "logrecord.h"
+
+namespace core
+{
+
+const char* severity_name(Severity severity) noexcept
+{
+    switch (severity)
+    {
+        case Severity::Trace:   return "trace";
+        case Severity::Debug:   return "debug";
+        case Severity::Info:    return "info";
+        case Severity::Warning: return "warning";
+        case Severity::Error:   return "error";
+        case Severity::Fatal:   return "fatal";
+    }
+
+    return "unknown";
+}
+
+} // namespace core
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+
+namespace core
+{
+
+enum class Severity
+{
+    Trace,
+    Debug,
+    Info,
+    Warning,
+    Error,
+    Fatal
+};
+
+const char* severity_name(Severity severity) noexcept;
+
+struct LogRecord
+{
+    std::string                             message;
+    Severity                                severity;
+    std::chrono::system_clock::time_point   timestamp;
+};
+
+} // namespace core
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "logrecord.h"
+
+#include "foundation/immutable/vector.h"
+
+namespace core
+{
+
+/**
+ *  Destination log records are written to, see Logger::add_sink().
+ *
+ *  Sinks are called on the logger queue, one call at a time, with the batch
+ *  of records appended since the previous call. Errors are reported
+ *  by throwing std::exception, the logger drops the failed batch and
+ *  reports the error (see Logger::set_sink_error_handler()).
+ */
+class LogSink
+{
+  public:
+    using Records = foundation::immutable::Vector<LogRecord>;
+
+    virtual ~LogSink() = default;
+
+    virtual void write(const Records& records) = 0;
+
+    /**
+     *  Hand the records written so far over to the OS.
+     */
+    virtual void flush()
+    {}
+};
+
+} // namespace core
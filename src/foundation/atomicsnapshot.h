@@ -0,0 +1,207 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace foundation
+{
+
+/**
+ *  Immutable value published through an atomic pointer.
+ *
+ *  Reading is wait-free: load() is a single fetch_add on a word packing
+ *  the pointer to the current value with the number of loads since it
+ *  was published (split reference count), releasing a snapshot is
+ *  a single fetch_sub on the value's own counter. Writers replace
+ *  the value with compare-and-swap, so they are lock-free as well.
+ *
+ *  Relies on user space pointers fitting into 48 bits.
+ */
+template <typename T>
+class AtomicSnapshot
+{
+    struct Node
+    {
+        explicit Node(T value)
+          : m_value(std::move(value))
+          , m_count(published_bias)
+        {}
+
+        T                           m_value;
+
+        // Loads folded in from the published word minus released snapshots,
+        // plus published_bias while the node is published.
+        std::atomic<std::int64_t>   m_count;
+    };
+
+  public:
+    /**
+     *  Reference to the value that was current when load() was called.
+     */
+    class Snapshot
+    {
+      public:
+        Snapshot(Snapshot&& other) noexcept
+          : m_node(std::exchange(other.m_node, nullptr))
+        {}
+
+        Snapshot(const Snapshot&) = delete;
+        Snapshot& operator=(const Snapshot&) = delete;
+        Snapshot& operator=(Snapshot&&) = delete;
+
+        ~Snapshot()
+        {
+            if (m_node && m_node->m_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                delete m_node;
+            }
+        }
+
+        const T& operator*() const noexcept
+        {
+            return m_node->m_value;
+        }
+
+        const T* operator->() const noexcept
+        {
+            return &m_node->m_value;
+        }
+
+      private:
+        friend class AtomicSnapshot;
+
+        explicit Snapshot(Node* node) noexcept
+          : m_node(node)
+        {}
+
+        Node* m_node;
+    };
+
+    explicit AtomicSnapshot(T value = T())
+      : m_word(pack(new Node(std::move(value)), 0u))
+    {}
+
+    AtomicSnapshot(const AtomicSnapshot&) = delete;
+    AtomicSnapshot& operator=(const AtomicSnapshot&) = delete;
+
+    ~AtomicSnapshot()
+    {
+        const auto word = m_word.load(std::memory_order_acquire);
+        retire(pointer(word), count(word));
+    }
+
+    Snapshot load() const noexcept
+    {
+        const auto word = m_word.fetch_add(count_one, std::memory_order_acquire);
+        const auto node = pointer(word);
+
+        // Fold the loads into the node counter before the packed count
+        // overflows. If the word has changed since, whoever changed it
+        // takes care of the count.
+        if (count(word) + 1u >= renormalize_threshold)
+        {
+            auto expected = word + count_one;
+
+            if (m_word.compare_exchange_strong(
+                    expected,
+                    pack(node, 0u),
+                    std::memory_order_acq_rel,
+                    std::memory_order_relaxed))
+            {
+                node->m_count.fetch_add(
+                    static_cast<std::int64_t>(count(word) + 1u),
+                    std::memory_order_relaxed);
+            }
+        }
+
+        return Snapshot(node);
+    }
+
+    void store(T value)
+    {
+        const auto word = m_word.exchange(
+            pack(new Node(std::move(value)), 0u),
+            std::memory_order_acq_rel);
+
+        retire(pointer(word), count(word));
+    }
+
+    /**
+     *  Replace the value with fn(current value). fn may be called
+     *  more than once if other writers update the value concurrently.
+     */
+    template <typename Fn>
+    void update(Fn fn)
+    {
+        for (;;)
+        {
+            const auto current = load();
+            auto node = std::make_unique<Node>(fn(*current));
+
+            auto expected = m_word.load(std::memory_order_relaxed);
+
+            // The count changes with every load, retry until
+            // the value itself changes.
+            while (pointer(expected) == current.m_node)
+            {
+                if (m_word.compare_exchange_weak(
+                        expected,
+                        pack(node.get(), 0u),
+                        std::memory_order_acq_rel,
+                        std::memory_order_relaxed))
+                {
+                    node.release();
+                    retire(current.m_node, count(expected));
+                    return;
+                }
+            }
+        }
+    }
+
+  private:
+    static constexpr unsigned       pointer_bits = 48u;
+    static constexpr std::uint64_t  pointer_mask = (std::uint64_t(1u) << pointer_bits) - 1u;
+    static constexpr std::uint64_t  count_one = std::uint64_t(1u) << pointer_bits;
+    static constexpr std::uint64_t  renormalize_threshold = std::uint64_t(1u) << 15u;
+
+    // Large enough for the count to stay positive
+    // as long as the node is published.
+    static constexpr std::int64_t   published_bias = std::int64_t(1) << 62;
+
+    static_assert(sizeof(void*) == 8u, "A pointer and a count are packed into 64 bits.");
+
+    static std::uint64_t pack(Node* node, std::uint64_t count) noexcept
+    {
+        return reinterpret_cast<std::uint64_t>(node) | (count << pointer_bits);
+    }
+
+    static Node* pointer(std::uint64_t word) noexcept
+    {
+        return reinterpret_cast<Node*>(word & pointer_mask);
+    }
+
+    static std::uint64_t count(std::uint64_t word) noexcept
+    {
+        return word >> pointer_bits;
+    }
+
+    /**
+     *  Drop the reference of the publisher, once the node is not published
+     *  anymore, load_count being the loads not yet folded into the node.
+     */
+    static void retire(Node* node, std::uint64_t load_count) noexcept
+    {
+        const auto delta = static_cast<std::int64_t>(load_count) - published_bias;
+
+        if (node->m_count.fetch_add(delta, std::memory_order_acq_rel) + delta == 0)
+        {
+            delete node;
+        }
+    }
+
+    mutable std::atomic<std::uint64_t> m_word;
+};
+
+} // namespace foundation
@@ -0,0 +1,197 @@
+#include "contentcache.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+namespace foundation
+{
+
+namespace
+{
+
+struct DigestHash
+{
+    std::size_t operator()(const ContentCache::Digest& digest) const noexcept
+    {
+        // Already well mixed.
+        return static_cast<std::size_t>(digest.first);
+    }
+};
+
+} // namespace
+
+struct ContentCache::Impl
+{
+    struct Entry
+    {
+        Digest          m_digest;
+        Value           m_value;
+        std::size_t     m_cost;
+    };
+
+    using Entries = std::list<Entry>;
+
+    struct Shard
+    {
+        std::mutex                                                  m_mutex;
+
+        // Most recently used first.
+        Entries                                                     m_entries;
+        std::unordered_map<Digest, Entries::iterator, DigestHash>   m_index;
+        std::size_t                                                 m_cost = 0u;
+        std::size_t                                                 m_capacity = 0u;
+    };
+
+    Shard& shard(const Digest& digest) noexcept
+    {
+        // The index hashes the first half.
+        return m_shards[digest.second % m_shards_count];
+    }
+
+    void erase(Shard& shard, Entries::iterator it)
+    {
+        shard.m_cost -= it->m_cost;
+        shard.m_index.erase(it->m_digest);
+        shard.m_entries.erase(it);
+    }
+
+    std::size_t                 m_shards_count;
+    std::unique_ptr<Shard[]>    m_shards;
+
+    std::atomic<std::uint64_t>  m_hits {0u};
+    std::atomic<std::uint64_t>  m_misses {0u};
+    std::atomic<std::uint64_t>  m_evictions {0u};
+};
+
+ContentCache::ContentCache(std::size_t capacity, std::size_t shards_count)
+{
+    if (shards_count == 0u)
+    {
+        throw std::invalid_argument("Content cache needs at least one shard.");
+    }
+
+    // Every shard holds at least one entry, more shards than
+    // the capacity would hold more entries than the capacity.
+    shards_count = std::max<std::size_t>(std::min(shards_count, capacity), 1u);
+
+    m_impl = new Impl;
+    m_impl->m_shards_count = shards_count;
+    m_impl->m_shards = std::make_unique<Impl::Shard[]>(shards_count);
+
+    // Split the capacity exactly, the first shards take the remainder.
+    for (std::size_t i = 0; i < shards_count; ++i)
+    {
+        m_impl->m_shards[i].m_capacity = capacity / shards_count + (i < capacity % shards_count ? 1u : 0u);
+    }
+}
+
+ContentCache::~ContentCache()
+{
+    delete m_impl;
+}
+
+std::optional<ContentCache::Value> ContentCache::get(const MurmurHash& hash)
+{
+    const auto digest = hash.as_128bit();
+    auto& shard = m_impl->shard(digest);
+
+    std::lock_guard<std::mutex> lock(shard.m_mutex);
+
+    const auto it = shard.m_index.find(digest);
+
+    if (it == shard.m_index.end())
+    {
+        m_impl->m_misses.fetch_add(1u, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+
+    shard.m_entries.splice(shard.m_entries.begin(), shard.m_entries, it->second);
+    m_impl->m_hits.fetch_add(1u, std::memory_order_relaxed);
+
+    const Value& value = it->second->m_value;
+    return value;
+}
+
+void ContentCache::put(const MurmurHash& hash, Value value, std::size_t cost)
+{
+    const auto digest = hash.as_128bit();
+    auto& shard = m_impl->shard(digest);
+
+    std::lock_guard<std::mutex> lock(shard.m_mutex);
+
+    const auto it = shard.m_index.find(digest);
+
+    // The previous value is stale even if the new one is not cached.
+    if (it != shard.m_index.end())
+    {
+        m_impl->erase(shard, it->second);
+    }
+
+    if (cost > shard.m_capacity)
+    {
+        return;
+    }
+
+    shard.m_entries.push_front(Impl::Entry {digest, std::move(value), cost});
+    shard.m_index.emplace(digest, shard.m_entries.begin());
+    shard.m_cost += cost;
+
+    std::uint64_t evictions = 0u;
+
+    while (shard.m_cost > shard.m_capacity)
+    {
+        m_impl->erase(shard, std::prev(shard.m_entries.end()));
+        ++evictions;
+    }
+
+    if (evictions != 0u)
+    {
+        m_impl->m_evictions.fetch_add(evictions, std::memory_order_relaxed);
+    }
+}
+
+void ContentCache::clear()
+{
+    for (std::size_t i = 0; i < m_impl->m_shards_count; ++i)
+    {
+        auto& shard = m_impl->m_shards[i];
+
+        std::lock_guard<std::mutex> lock(shard.m_mutex);
+
+        shard.m_index.clear();
+        shard.m_entries.clear();
+        shard.m_cost = 0u;
+    }
+}
+
+std::size_t ContentCache::size() const
+{
+    std::size_t result = 0u;
+
+    for (std::size_t i = 0; i < m_impl->m_shards_count; ++i)
+    {
+        auto& shard = m_impl->m_shards[i];
+
+        std::lock_guard<std::mutex> lock(shard.m_mutex);
+        result += shard.m_entries.size();
+    }
+
+    return result;
+}
+
+ContentCache::Stats ContentCache::stats() const noexcept
+{
+    return Stats {
+        m_impl->m_hits.load(std::memory_order_relaxed),
+        m_impl->m_misses.load(std::memory_order_relaxed),
+        m_impl->m_evictions.load(std::memory_order_relaxed)};
+}
+
+} // namespace foundation
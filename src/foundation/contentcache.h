@@ -0,0 +1,95 @@
+#pragma once
+
+#include "foundation/murmurhash.h"
+#include "foundation/sharedany.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+namespace foundation
+{
+
+/**
+ *  Thread safe cache of results addressed by the MurmurHash of
+ *  their inputs, e.g. node evaluation results keyed by the hash
+ *  of the node and its inputs.
+ *
+ *  Entries are keyed by the full 128 bit digest. Each entry has a cost
+ *  (1 by default), least recently used entries are evicted once the total
+ *  cost exceeds the capacity. The cache is split into shards with their
+ *  own lock and LRU order, each holding a share of the capacity.
+ */
+class ContentCache
+{
+  public:
+    using Digest = std::pair<std::uint64_t, std::uint64_t>;
+    using Value  = immutable::SharedAny;
+
+    struct Stats
+    {
+        std::uint64_t hits;
+        std::uint64_t misses;
+        std::uint64_t evictions;
+    };
+
+    /**
+     *  The capacity is split between the shards, their shares add up to
+     *  exactly the capacity. The shards count is clamped to the capacity,
+     *  so that every shard can hold at least one entry.
+     */
+    explicit ContentCache(std::size_t capacity, std::size_t shards_count = 16);
+    ~ContentCache();
+
+    ContentCache(const ContentCache&) = delete;
+    ContentCache& operator=(const ContentCache&) = delete;
+
+    /**
+     *  Return the value cached under hash and mark it as recently used.
+     */
+    std::optional<Value> get(const MurmurHash& hash);
+
+    /**
+     *  Cache value under hash, replacing the previous value if any.
+     *  Values costing more than a shard can hold are not cached,
+     *  the previous value is still dropped.
+     */
+    void put(const MurmurHash& hash, Value value, std::size_t cost = 1u);
+
+    /**
+     *  Return the value cached under hash, or compute, cache and return it.
+     *  Concurrent misses on the same hash may compute the value more than once.
+     */
+    template <typename Fn>
+    Value get_or_compute(const MurmurHash& hash, Fn compute);
+
+    void clear();
+
+    /**
+     *  Number of cached entries.
+     */
+    std::size_t size() const;
+
+    Stats stats() const noexcept;
+
+  private:
+    struct Impl;
+    Impl* m_impl;
+};
+
+template <typename Fn>
+ContentCache::Value ContentCache::get_or_compute(const MurmurHash& hash, Fn compute)
+{
+    if (auto cached = get(hash))
+    {
+        return std::move(*cached);
+    }
+
+    Value value(compute());
+    put(hash, value);
+
+    return value;
+}
+
+} // namespace foundation
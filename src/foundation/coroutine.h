@@ -0,0 +1,427 @@
+#pragma once
+
+#if !defined(__cpp_impl_coroutine)
+#error "foundation/coroutine.h requires C++20 coroutine support."
+#endif
+
+#include "foundation/taskqueue.h"
+
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace foundation
+{
+
+template <typename T = void>
+class Task;
+
+namespace detail
+{
+
+struct TaskPromiseBase
+{
+    struct FinalAwaiter
+    {
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        // Symmetric transfer to the awaiting coroutine.
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+        {
+            auto continuation = handle.promise().m_continuation;
+            return continuation ? continuation : std::noop_coroutine();
+        }
+
+        void await_resume() noexcept
+        {}
+    };
+
+    // Tasks are lazy: the body doesn't start until the task is awaited.
+    std::suspend_always initial_suspend() noexcept
+    {
+        return {};
+    }
+
+    FinalAwaiter final_suspend() noexcept
+    {
+        return {};
+    }
+
+    std::coroutine_handle<> m_continuation;
+};
+
+template <typename T>
+struct TaskPromise : public TaskPromiseBase
+{
+    Task<T> get_return_object() noexcept;
+
+    template <typename U,
+              std::enable_if_t<std::is_convertible_v<U&&, T>, int> = 0>
+    void return_value(U&& value)
+    {
+        m_result.template emplace<1>(std::forward<U>(value));
+    }
+
+    void unhandled_exception() noexcept
+    {
+        m_result.template emplace<2>(std::current_exception());
+    }
+
+    T result()
+    {
+        if (m_result.index() == 2)
+        {
+            std::rethrow_exception(std::get<2>(m_result));
+        }
+
+        return std::move(std::get<1>(m_result));
+    }
+
+    std::variant<std::monostate, T, std::exception_ptr> m_result;
+};
+
+template <>
+struct TaskPromise<void> : public TaskPromiseBase
+{
+    Task<void> get_return_object() noexcept;
+
+    void return_void() noexcept
+    {}
+
+    void unhandled_exception() noexcept
+    {
+        m_exception = std::current_exception();
+    }
+
+    void result()
+    {
+        if (m_exception)
+        {
+            std::rethrow_exception(m_exception);
+        }
+    }
+
+    std::exception_ptr m_exception;
+};
+
+} // namespace detail
+
+/**
+ *  Lazily started coroutine producing a value of type T.
+ *
+ *  The body runs when the task is first awaited, on the awaiting thread,
+ *  and the awaiting coroutine is resumed right after the body completes.
+ *  Awaiting doesn't allocate: the awaiter lives in the awaiting frame,
+ *  and the frame of the task itself is a candidate for allocation elision
+ *  since its lifetime is bound to the Task object.
+ */
+template <typename T>
+class Task
+{
+  public:
+    using promise_type = detail::TaskPromise<T>;
+    using Handle       = std::coroutine_handle<promise_type>;
+
+    class Awaiter
+    {
+      public:
+        explicit Awaiter(Handle handle) noexcept
+          : m_handle(handle)
+        {}
+
+        bool await_ready() const noexcept
+        {
+            return m_handle.done();
+        }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+        {
+            m_handle.promise().m_continuation = awaiting;
+            return m_handle;
+        }
+
+        T await_resume()
+        {
+            return m_handle.promise().result();
+        }
+
+      private:
+        Handle m_handle;
+    };
+
+    explicit Task(Handle handle) noexcept
+      : m_handle(handle)
+    {}
+
+    Task(Task&& other) noexcept
+      : m_handle(std::exchange(other.m_handle, nullptr))
+    {}
+
+    Task& operator=(Task&& other) noexcept
+    {
+        if (this != &other)
+        {
+            destroy();
+            m_handle = std::exchange(other.m_handle, nullptr);
+        }
+
+        return *this;
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task()
+    {
+        destroy();
+    }
+
+    bool is_ready() const noexcept
+    {
+        return m_handle.done();
+    }
+
+    Awaiter operator co_await() const& noexcept
+    {
+        return Awaiter(m_handle);
+    }
+
+    Awaiter operator co_await() const&& noexcept
+    {
+        return Awaiter(m_handle);
+    }
+
+  private:
+    template <typename U>
+    friend U sync_wait(Task<U> task);
+
+    void destroy() noexcept
+    {
+        if (m_handle)
+        {
+            m_handle.destroy();
+            m_handle = nullptr;
+        }
+    }
+
+    Handle m_handle;
+};
+
+namespace detail
+{
+
+template <typename T>
+Task<T> TaskPromise<T>::get_return_object() noexcept
+{
+    return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept
+{
+    return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+class SyncWaitEvent
+{
+  public:
+    void set()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_is_set = true;
+        m_cv.notify_all();
+    }
+
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [this]() { return m_is_set; });
+    }
+
+  private:
+    std::mutex              m_mutex;
+    std::condition_variable m_cv;
+    bool                    m_is_set = false;
+};
+
+class SyncWaitTask
+{
+  public:
+    struct promise_type
+    {
+        struct FinalAwaiter
+        {
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            // Signal only once the frame is suspended,
+            // so that the waiting thread may destroy it.
+            void await_suspend(std::coroutine_handle<promise_type> handle) noexcept
+            {
+                handle.promise().m_event->set();
+            }
+
+            void await_resume() noexcept
+            {}
+        };
+
+        SyncWaitTask get_return_object() noexcept
+        {
+            return SyncWaitTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept
+        {
+            return {};
+        }
+
+        FinalAwaiter final_suspend() noexcept
+        {
+            return {};
+        }
+
+        void return_void() noexcept
+        {}
+
+        void unhandled_exception() noexcept
+        {
+            std::terminate();
+        }
+
+        SyncWaitEvent* m_event = nullptr;
+    };
+
+    explicit SyncWaitTask(std::coroutine_handle<promise_type> handle) noexcept
+      : m_handle(handle)
+    {}
+
+    SyncWaitTask(const SyncWaitTask&) = delete;
+    SyncWaitTask& operator=(const SyncWaitTask&) = delete;
+
+    ~SyncWaitTask()
+    {
+        m_handle.destroy();
+    }
+
+    void run(SyncWaitEvent& event)
+    {
+        m_handle.promise().m_event = &event;
+        m_handle.resume();
+        event.wait();
+    }
+
+  private:
+    std::coroutine_handle<promise_type> m_handle;
+};
+
+template <typename T>
+class WhenReadyAwaiter
+{
+  public:
+    explicit WhenReadyAwaiter(std::coroutine_handle<TaskPromise<T>> handle) noexcept
+      : m_handle(handle)
+    {}
+
+    bool await_ready() const noexcept
+    {
+        return m_handle.done();
+    }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+    {
+        m_handle.promise().m_continuation = awaiting;
+        return m_handle;
+    }
+
+    // The result (or the error) is retrieved by sync_wait itself.
+    void await_resume() noexcept
+    {}
+
+  private:
+    std::coroutine_handle<TaskPromise<T>> m_handle;
+};
+
+template <typename T>
+SyncWaitTask make_sync_wait_task(std::coroutine_handle<TaskPromise<T>> handle)
+{
+    co_await WhenReadyAwaiter<T>(handle);
+}
+
+} // namespace detail
+
+/**
+ *  Awaiter resuming the coroutine on a TaskQueue.
+ *
+ *  If the queue has already been shut down, the coroutine is resumed
+ *  right away on the awaiting thread and the co_await expression throws
+ *  std::runtime_error. A resumption still pending when a timed out
+ *  shutdown() or the destructor discards the queued tasks is lost,
+ *  so queues must outlive the coroutines scheduled on them.
+ */
+class ScheduleAwaiter
+{
+  public:
+    explicit ScheduleAwaiter(TaskQueue& queue) noexcept
+      : m_queue(queue)
+    {}
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    bool await_suspend(std::coroutine_handle<> handle)
+    {
+        // The coroutine may be resumed on a worker thread before post() returns,
+        // so this object is only touched when the task was rejected.
+        if (m_queue.post([handle]() { handle.resume(); }))
+        {
+            return true;
+        }
+
+        m_is_rejected = true;
+        return false;
+    }
+
+    void await_resume() const
+    {
+        if (m_is_rejected)
+        {
+            throw std::runtime_error("Can't schedule on a TaskQueue that has been shut down.");
+        }
+    }
+
+  private:
+    TaskQueue&  m_queue;
+    bool        m_is_rejected = false;
+};
+
+inline ScheduleAwaiter operator co_await(TaskQueue::Scheduler scheduler) noexcept
+{
+    return ScheduleAwaiter(scheduler.queue);
+}
+
+/**
+ *  Run the task and block the calling thread until it completes.
+ *  Rethrows the exception thrown by the task body, if any.
+ */
+template <typename T>
+T sync_wait(Task<T> task)
+{
+    detail::SyncWaitEvent event;
+    detail::make_sync_wait_task<T>(task.m_handle).run(event);
+
+    return task.m_handle.promise().result();
+}
+
+} // namespace foundation
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace foundation
+{
+
+/**
+ *  Histogram with power-of-two buckets, suitable for latencies.
+ *  Bucket i counts the samples in [2^i, 2^(i + 1)), bucket 0 also counts zeroes.
+ *
+ *  Not thread safe.
+ */
+class Histogram
+{
+  public:
+    static constexpr std::size_t buckets_count = 48;
+
+    Histogram() noexcept
+    {
+        reset();
+    }
+
+    void record(std::uint64_t value) noexcept
+    {
+        ++m_buckets[bucket_index(value)];
+        ++m_count;
+        m_sum += value;
+
+        if (value > m_max)
+        {
+            m_max = value;
+        }
+    }
+
+    void reset() noexcept
+    {
+        m_buckets.fill(0u);
+        m_count = 0u;
+        m_sum = 0u;
+        m_max = 0u;
+    }
+
+    std::uint64_t count() const noexcept
+    {
+        return m_count;
+    }
+
+    std::uint64_t bucket(std::size_t i) const noexcept
+    {
+        return m_buckets[i];
+    }
+
+    std::uint64_t max() const noexcept
+    {
+        return m_max;
+    }
+
+    std::uint64_t mean() const noexcept
+    {
+        return m_count != 0u ? m_sum / m_count : 0u;
+    }
+
+    /**
+     *  Upper bound of the bucket holding the given percentile, p in [0, 1].
+     */
+    std::uint64_t percentile(double p) const noexcept
+    {
+        if (m_count == 0u)
+        {
+            return 0u;
+        }
+
+        const auto rank = static_cast<std::uint64_t>(p * static_cast<double>(m_count - 1u));
+        std::uint64_t seen = 0u;
+
+        for (std::size_t i = 0; i < buckets_count; ++i)
+        {
+            seen += m_buckets[i];
+
+            if (seen > rank)
+            {
+                const auto upper_bound = (std::uint64_t(1u) << (i + 1)) - 1u;
+                return upper_bound < m_max ? upper_bound : m_max;
+            }
+        }
+
+        return m_max;
+    }
+
+  private:
+    static std::size_t bucket_index(std::uint64_t value) noexcept
+    {
+        if (value == 0u)
+        {
+            return 0u;
+        }
+
+        const auto i = static_cast<std::size_t>(63 - __builtin_clzll(value));
+        return i < buckets_count ? i : buckets_count - 1u;
+    }
+
+    std::array<std::uint64_t, buckets_count>    m_buckets;
+    std::uint64_t                               m_count;
+    std::uint64_t                               m_sum;
+    std::uint64_t                               m_max;
+};
+
+} // namespace foundation
@@ -15,7 +15,7 @@ namespace immutable
 {
 
 template <typename Key,
-          typename Hash = std::hash<Key>,
+          typename Hash = DefaultHasher<Key>,
           typename MemoryPolicy = detail::HeapMemoryPolicy>
 class AnyTypeMap
 {
@@ -61,6 +61,17 @@ class AnyTypeMap
         return nullptr;
     }
 
+    /**
+     *  Pointer to the value under key if it is a ValueType, nullptr
+     *  otherwise. Unlike getattr(), never allocates.
+     */
+    template<typename ValueType>
+    const ValueType* find(const Key& key) const
+    {
+        auto el = m_map.get(key);
+        return el ? el->template get<ValueType>() : nullptr;
+    }
+
   private:
     AnyTypeMap(InnerMap&& m)
       : m_map(std::move(m))
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "memorypolicy.h"
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace foundation
+{
+namespace immutable
+{
+namespace detail
+{
+
+/**
+ *  Fixed capacity buffer shared between versions of a persistent container.
+ *
+ *  Elements are never modified once constructed. A free slot belongs to the
+ *  first version that appends to it: other versions see the append fail
+ *  and have to copy the buffer instead.
+ */
+template <typename T, typename MemoryPolicy>
+class AppendBuffer
+{
+  public:
+    static_assert(
+        std::is_nothrow_move_constructible_v<T>,
+        "A claimed slot must always end up constructed.");
+
+    explicit AppendBuffer(std::size_t capacity)
+      : m_data(MemoryPolicy::template allocate<T>(capacity))
+      , m_capacity(capacity)
+      , m_size(0u)
+    {}
+
+    AppendBuffer(const AppendBuffer&) = delete;
+    AppendBuffer& operator=(const AppendBuffer&) = delete;
+
+    ~AppendBuffer()
+    {
+        const auto size = m_size.load(std::memory_order_acquire);
+
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            MemoryPolicy::destroy(m_data + i);
+        }
+
+        MemoryPolicy::deallocate(m_data, m_capacity);
+    }
+
+    std::size_t capacity() const noexcept
+    {
+        return m_capacity;
+    }
+
+    /**
+     *  Move value into the buffer if it holds exactly expected_size elements.
+     *  Leaves value untouched and returns false otherwise.
+     */
+    bool try_append(std::size_t expected_size, T& value) noexcept
+    {
+        if (expected_size >= m_capacity)
+        {
+            return false;
+        }
+
+        if (!m_size.compare_exchange_strong(
+                expected_size,
+                expected_size + 1u,
+                std::memory_order_acq_rel))
+        {
+            return false;
+        }
+
+        MemoryPolicy::construct(m_data + expected_size, std::move(value));
+        return true;
+    }
+
+    const T& operator[](std::size_t i) const noexcept
+    {
+        return m_data[i];
+    }
+
+  private:
+    T* const                    m_data;
+    const std::size_t           m_capacity;
+    std::atomic<std::size_t>    m_size;
+};
+
+} // namespace detail
+} // namespace immutable
+} // namespace foundation
@@ -160,6 +160,20 @@ struct HamtNode : public Refcounted
         return collision().size;
     }
 
+    /**
+     *  Every node owns its arrays, nodes derived from this one
+     *  get copies of the arrays they don't change.
+     */
+    Data* copy_data() const
+    {
+        return datamap() ? make_array<MemoryPolicy>(data(), data_size()) : nullptr;
+    }
+
+    HamtNode** copy_children() const
+    {
+        return nodemap() ? make_array<MemoryPolicy>(children(), children_size()) : nullptr;
+    }
+
     static void inc_children(HamtNode** first, HamtNode** last) noexcept
     {
         for (; first < last; ++first)
@@ -262,7 +276,7 @@ struct HamtNode : public Refcounted
             std::move(value));
 
         dest->inner().nodemap = nodemap();
-        dest->inner().children = children();
+        dest->inner().children = copy_children();
 
         inc_children(children(), children() + children_size());
 
@@ -283,7 +297,7 @@ struct HamtNode : public Refcounted
             std::move(value));
 
         dest->inner().nodemap = nodemap();
-        dest->inner().children = children();
+        dest->inner().children = copy_children();
 
         inc_children(children(), children() + children_size());
 
@@ -301,7 +315,7 @@ struct HamtNode : public Refcounted
             d_compact_idx);
 
         dest->inner().nodemap = nodemap();
-        dest->inner().children = children();
+        dest->inner().children = copy_children();
 
         inc_children(children(), children() + children_size());
 
@@ -316,7 +330,7 @@ struct HamtNode : public Refcounted
         auto size = children_size();
 
         dest->inner().datamap = datamap();
-        dest->inner().data = data();
+        dest->inner().data = copy_data();
         dest->inner().nodemap = nodemap();
         dest->inner().children = make_array_replace<MemoryPolicy>(
             first,
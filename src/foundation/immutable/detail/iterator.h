@@ -35,11 +35,8 @@ class Iterator
     Iterator() = default;
     explicit Iterator(Node* const* const root)
     {
-        if ((*root)->children_size() != 0 || (*root)->data_size() != 0)
-        {
-            m_way_to_root[++m_current_depth] = root;
-            descent_and_define_data();
-        }
+        m_way_to_root[++m_current_depth] = root;
+        define_data_or_advance();
     }
 
     bool operator==(const Iterator& other) const noexcept
@@ -79,60 +76,62 @@ class Iterator
   private:
     void next_node() noexcept
     {
-        auto current_node = m_way_to_root[m_current_depth];
+        if (am_i_end())
+        {
+            return;
+        }
 
-        if (!am_i_end())
+        if (++m_this_data == m_last_data && advance())
         {
-            if (m_this_data + 1 != m_last_data)
-            {
-                ++m_this_data;
-            }
-            else if (m_current_depth != 0)
-            {
-                while (!am_i_end())
-                {
-                    current_node = m_way_to_root[m_current_depth];
-                    if (!((*current_node)->is_inner()) || !can_i_shift())
-                    {
-                        --m_current_depth;
-                    }
-                    else
-                    {
-                       ++m_way_to_root[m_current_depth];
-                       descent_and_define_data();
-                       break;
-                    }
-
-                    if (m_current_depth == 0 && (*m_way_to_root[m_current_depth])->data_size() == 0)
-                    {
-                        transform_to_end();
-                    }
-                }
-            }
-            else
+            define_data_or_advance();
+        }
+    }
+
+    /**
+     *  Nodes are visited in pre-order: the data of an inner node
+     *  comes before the data of its children.
+     */
+    void define_data_or_advance() noexcept
+    {
+        do
+        {
+            define_data((*m_way_to_root[m_current_depth])->is_inner());
+
+            if (m_this_data != m_last_data)
             {
-                transform_to_end();
+                return;
             }
         }
+        while (advance());
     }
 
-    void descent_and_define_data() noexcept
+    /**
+     *  Move to the node following the current one,
+     *  returns false if there is none.
+     */
+    bool advance() noexcept
     {
         auto current_node = m_way_to_root[m_current_depth];
-        auto inner = (*current_node)->is_inner();
-        while ((*current_node)->children_size())
+
+        if ((*current_node)->is_inner() && (*current_node)->children_size() != 0)
         {
-            current_node = (*current_node)->children();
-            m_way_to_root[++m_current_depth] = current_node;
-            inner = (*current_node)->is_inner();
+            m_way_to_root[++m_current_depth] = (*current_node)->children();
+            return true;
+        }
 
-            if (!inner)
+        while (m_current_depth != 0)
+        {
+            if (can_i_shift())
             {
-                break;
+                ++m_way_to_root[m_current_depth];
+                return true;
             }
+
+            --m_current_depth;
         }
 
-        define_data(inner);
+        transform_to_end();
+        return false;
     }
 
     void define_data(bool inner) noexcept {
@@ -148,7 +147,7 @@ class Iterator
         }
     }
 
-    bool can_i_shift() const
+    bool can_i_shift() const noexcept
     {
         auto current_node = m_way_to_root[m_current_depth];
         auto parent = m_way_to_root[m_current_depth-1];
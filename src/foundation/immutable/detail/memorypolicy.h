@@ -2,6 +2,7 @@
 
 #include <cstddef>
 #include <memory>
+#include <utility>
 
 namespace foundation
 {
@@ -27,13 +28,15 @@ struct HeapMemoryPolicy
     template <typename T, typename... Args>
     static void construct(T* pointer, Args&&... args)
     {
-        std::allocator<T> {}.construct(pointer, std::forward<Args>(args)...);
+        std::allocator<T> allocator;
+        std::allocator_traits<std::allocator<T>>::construct(allocator, pointer, std::forward<Args>(args)...);
     }
 
     template <typename T>
     static void destroy(T* pointer)
     {
-        std::allocator<T> {}.destroy(pointer);
+        std::allocator<T> allocator;
+        std::allocator_traits<std::allocator<T>>::destroy(allocator, pointer);
     }
 };
 
@@ -4,6 +4,8 @@
 #include "detail/iterator.h"
 #include "detail/hamtnode.h"
 
+#include "foundation/murmurhash.h"
+
 #include <cstddef>
 #include <functional>
 #include <stdexcept>
@@ -16,7 +18,7 @@ namespace immutable
 
 template <typename Key,
           typename Value,
-          typename Hash = std::hash<Key>,
+          typename Hash = DefaultHasher<Key>,
           typename MemoryPolicy = detail::HeapMemoryPolicy>
 class Map
 {
@@ -0,0 +1,248 @@
+#pragma once
+
+#include "detail/appendbuffer.h"
+#include "detail/memorypolicy.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+namespace foundation
+{
+namespace immutable
+{
+
+/**
+ *  Persistent vector optimized for appending to the back
+ *  and dropping from the front.
+ *
+ *  Elements are stored in fixed size segments shared between versions,
+ *  so copying a vector is O(1) and push_back() is amortized O(1):
+ *  the new version reuses the free space of the segment it was appended to,
+ *  unless another version has already used it.
+ */
+template <typename T,
+          std::size_t SegmentSize = 256u,
+          typename MemoryPolicy = detail::HeapMemoryPolicy>
+class Vector
+{
+    static_assert(SegmentSize > 0u, "Segment can't be empty.");
+
+    using Segment       = detail::AppendBuffer<T, MemoryPolicy>;
+    using SegmentPtr    = std::shared_ptr<Segment>;
+    using Directory     = detail::AppendBuffer<SegmentPtr, MemoryPolicy>;
+    using DirectoryPtr  = std::shared_ptr<Directory>;
+
+  public:
+    class Iterator
+    {
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const T*;
+        using reference         = const T&;
+
+        Iterator() = default;
+
+        Iterator(const Vector* vector, std::size_t index) noexcept
+          : m_vector(vector)
+          , m_index(index)
+        {}
+
+        bool operator==(const Iterator& other) const noexcept
+        {
+            return m_index == other.m_index;
+        }
+
+        bool operator!=(const Iterator& other) const noexcept
+        {
+            return !(*this == other);
+        }
+
+        Iterator& operator++() noexcept
+        {
+            ++m_index;
+            return *this;
+        }
+
+        Iterator operator++(int) noexcept
+        {
+            Iterator result(*this);
+
+            operator++();
+
+            return result;
+        }
+
+        const T& operator*() const noexcept
+        {
+            return (*m_vector)[m_index];
+        }
+
+        const T* operator->() const noexcept
+        {
+            return &(*m_vector)[m_index];
+        }
+
+      private:
+        const Vector*   m_vector = nullptr;
+        std::size_t     m_index = 0u;
+    };
+
+    Vector() noexcept
+      : m_begin(0u)
+      , m_end(0u)
+    {}
+
+    std::size_t size() const noexcept
+    {
+        return m_end - m_begin;
+    }
+
+    bool empty() const noexcept
+    {
+        return m_begin == m_end;
+    }
+
+    const T& operator[](std::size_t i) const noexcept
+    {
+        const auto index = m_begin + i;
+        return (*(*m_directory)[index / SegmentSize])[index % SegmentSize];
+    }
+
+    const T& front() const noexcept
+    {
+        return (*this)[0];
+    }
+
+    const T& back() const noexcept
+    {
+        return (*this)[size() - 1u];
+    }
+
+    Vector push_back(T value) const
+    {
+        const auto segment_index = m_end / SegmentSize;
+        const auto slot = m_end % SegmentSize;
+
+        if (slot != 0u)
+        {
+            const auto& segment = (*m_directory)[segment_index];
+
+            if (segment->try_append(slot, value))
+            {
+                return Vector(m_directory, m_begin, m_end + 1u);
+            }
+
+            // Another version owns the rest of the segment.
+            auto copy = std::make_shared<Segment>(SegmentSize);
+            for (std::size_t i = 0; i < slot; ++i)
+            {
+                T element((*segment)[i]);
+                copy->try_append(i, element);
+            }
+            copy->try_append(slot, value);
+
+            return rebuild(segment_index, std::move(copy), m_end + 1u);
+        }
+
+        auto segment = std::make_shared<Segment>(SegmentSize);
+        segment->try_append(0u, value);
+
+        if (m_directory && m_directory->try_append(segment_index, segment))
+        {
+            return Vector(m_directory, m_begin, m_end + 1u);
+        }
+
+        return rebuild(segment_index, std::move(segment), m_end + 1u);
+    }
+
+    /**
+     *  Drop the first count elements.
+     */
+    Vector drop_front(std::size_t count) const
+    {
+        if (count >= size())
+        {
+            return Vector();
+        }
+
+        Vector res(m_directory, m_begin + count, m_end);
+
+        // Release the directory slots of the dropped segments once they
+        // outnumber the live ones, so the memory is actually freed when
+        // no older version references them.
+        const auto dead_segments = res.m_begin / SegmentSize;
+        const auto live_segments = res.segments_end() - dead_segments;
+
+        if (dead_segments > live_segments)
+        {
+            return res.rebuild(res.segments_end(), nullptr, res.m_end);
+        }
+
+        return res;
+    }
+
+    Iterator begin() const noexcept
+    {
+        return Iterator(this, 0u);
+    }
+
+    Iterator end() const noexcept
+    {
+        return Iterator(this, size());
+    }
+
+  private:
+    static constexpr std::size_t min_directory_capacity = 8u;
+
+    Vector(DirectoryPtr directory, std::size_t begin, std::size_t end) noexcept
+      : m_directory(std::move(directory))
+      , m_begin(begin)
+      , m_end(end)
+    {}
+
+    // Index past the last segment holding elements.
+    std::size_t segments_end() const noexcept
+    {
+        return (m_end + SegmentSize - 1u) / SegmentSize;
+    }
+
+    /**
+     *  Make a version with a fresh directory referencing the live segments
+     *  before last_segment, followed by the given one (if any).
+     */
+    Vector rebuild(std::size_t last_segment, SegmentPtr segment, std::size_t end) const
+    {
+        const auto first_segment = m_begin / SegmentSize;
+        const auto live_segments = last_segment - first_segment + (segment ? 1u : 0u);
+
+        auto directory = std::make_shared<Directory>(
+            std::max(2u * live_segments, min_directory_capacity));
+
+        std::size_t i = 0u;
+        for (auto s = first_segment; s < last_segment; ++s, ++i)
+        {
+            SegmentPtr live = (*m_directory)[s];
+            directory->try_append(i, live);
+        }
+
+        if (segment)
+        {
+            directory->try_append(i, segment);
+        }
+
+        const auto offset = first_segment * SegmentSize;
+        return Vector(std::move(directory), m_begin - offset, end - offset);
+    }
+
+    DirectoryPtr    m_directory;
+    std::size_t     m_begin;
+    std::size_t     m_end;
+};
+
+} // namespace immutable
+} // namespace foundation
@@ -0,0 +1,798 @@
+#pragma once
+
+#include "foundation/vector.h"
+#include "foundation/vectorstream.h"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace foundation
+{
+
+namespace detail
+{
+
+template <std::size_t Size, typename Element>
+constexpr std::size_t matrix_alignment = alignof(Element);
+
+#ifdef MORPH_VECTOR_SSE
+
+// Rows of Matrix4<float> are loaded as SSE registers.
+template <>
+constexpr std::size_t matrix_alignment<4, float> = 16;
+
+#endif
+
+} // namespace detail
+
+//
+// Matrix declaration.
+//
+
+/**
+ *  Square matrix stored in row major order. Vectors are columns:
+ *  m * v transforms v, (a * b) * v == a * (b * v).
+ */
+template <std::size_t Size, typename Element>
+class Matrix
+{
+  public:
+    static constexpr std::size_t dimensions = Size;
+
+    /**
+     *  Zero matrix.
+     */
+    Matrix() noexcept;
+
+    /**
+     *  Elements in row major order.
+     */
+    explicit Matrix(const std::array<Element, Size * Size>& elements) noexcept;
+
+    static Matrix identity() noexcept;
+
+    Element& operator()(const std::size_t row, const std::size_t column) noexcept;
+    const Element& operator()(const std::size_t row, const std::size_t column) const noexcept;
+
+    /**
+     *  Elements in row major order.
+     */
+    Element* data() noexcept;
+    const Element* data() const noexcept;
+
+  private:
+    alignas(detail::matrix_alignment<Size, Element>)
+    std::array<Element, Size * Size> m_data;
+};
+
+template <typename Element>
+using Matrix3 = Matrix<3, Element>;
+
+using Matrix3f = Matrix3<float>;
+
+template <typename Element>
+using Matrix4 = Matrix<4, Element>;
+
+using Matrix4f = Matrix4<float>;
+
+template <std::size_t Size, typename T>
+Matrix<Size, T> operator*(const Matrix<Size, T>& lhs, const Matrix<Size, T>& rhs) noexcept;
+
+template <std::size_t Size, typename T>
+Vector<Size, T> operator*(const Matrix<Size, T>& lhs, const Vector<Size, T>& rhs) noexcept;
+
+template <std::size_t Size, typename T>
+bool operator==(const Matrix<Size, T>& lhs, const Matrix<Size, T>& rhs) noexcept;
+
+template <std::size_t Size, typename T>
+bool operator!=(const Matrix<Size, T>& lhs, const Matrix<Size, T>& rhs) noexcept;
+
+template <std::size_t Size, typename T>
+Matrix<Size, T> transpose(const Matrix<Size, T>& m) noexcept;
+
+template <std::size_t Size, typename T>
+T determinant(const Matrix<Size, T>& m) noexcept;
+
+/**
+ *  Throws std::domain_error if m is singular.
+ */
+template <std::size_t Size, typename T>
+Matrix<Size, T> inverse(const Matrix<Size, T>& m);
+
+/**
+ *  Affine transform applying linear, then translation.
+ */
+template <typename T>
+Matrix4<T> make_affine(const Matrix3<T>& linear, const Vector3<T>& translation) noexcept;
+
+/**
+ *  Transform the point p, m being affine (its last row is ignored).
+ */
+template <typename T>
+Vector3<T> transform_point(const Matrix4<T>& m, const Vector3<T>& p) noexcept;
+
+/**
+ *  Transform the direction d, ignoring the translation of m.
+ */
+template <typename T>
+Vector3<T> transform_direction(const Matrix4<T>& m, const Vector3<T>& d) noexcept;
+
+/**
+ *  out[i] = transform_point(m, points[i]), out may be points.
+ */
+template <typename T>
+void transform_points(const Matrix4<T>& m, const std::vector<Vector3<T>>& points, std::vector<Vector3<T>>& out);
+
+template <typename T>
+void transform_points(const Matrix4<T>& m, const VectorStream3<T>& points, VectorStream3<T>& out);
+
+//
+// Matrix implementation.
+//
+
+template <std::size_t Size, typename T>
+Matrix<Size, T>::Matrix() noexcept
+{
+    m_data.fill(T(0));
+}
+
+template <std::size_t Size, typename T>
+Matrix<Size, T>::Matrix(const std::array<T, Size * Size>& elements) noexcept
+  : m_data(elements)
+{}
+
+template <std::size_t Size, typename T>
+Matrix<Size, T> Matrix<Size, T>::identity() noexcept
+{
+    Matrix result;
+
+    for (std::size_t i = 0; i < Size; ++i)
+    {
+        result(i, i) = T(1);
+    }
+
+    return result;
+}
+
+template <std::size_t Size, typename T>
+T& Matrix<Size, T>::operator()(const std::size_t row, const std::size_t column) noexcept
+{
+    return m_data[row * Size + column];
+}
+
+template <std::size_t Size, typename T>
+const T& Matrix<Size, T>::operator()(const std::size_t row, const std::size_t column) const noexcept
+{
+    return m_data[row * Size + column];
+}
+
+template <std::size_t Size, typename T>
+T* Matrix<Size, T>::data() noexcept
+{
+    return m_data.data();
+}
+
+template <std::size_t Size, typename T>
+const T* Matrix<Size, T>::data() const noexcept
+{
+    return m_data.data();
+}
+
+template <std::size_t Size, typename T>
+Matrix<Size, T> operator*(const Matrix<Size, T>& lhs, const Matrix<Size, T>& rhs) noexcept
+{
+    Matrix<Size, T> res;
+    for (std::size_t i = 0; i < Size; ++i)
+    {
+        for (std::size_t k = 0; k < Size; ++k)
+        {
+            for (std::size_t j = 0; j < Size; ++j)
+            {
+                res(i, j) += lhs(i, k) * rhs(k, j);
+            }
+        }
+    }
+    return res;
+}
+
+template <std::size_t Size, typename T>
+Vector<Size, T> operator*(const Matrix<Size, T>& lhs, const Vector<Size, T>& rhs) noexcept
+{
+    auto res = rhs;
+    for (std::size_t i = 0; i < Size; ++i)
+    {
+        T sum = T(0);
+        for (std::size_t j = 0; j < Size; ++j)
+        {
+            sum += lhs(i, j) * rhs[j];
+        }
+        res[i] = sum;
+    }
+    return res;
+}
+
+template <std::size_t Size, typename T>
+bool operator==(const Matrix<Size, T>& lhs, const Matrix<Size, T>& rhs) noexcept
+{
+    for (std::size_t i = 0; i < Size * Size; ++i)
+    {
+        if (lhs.data()[i] != rhs.data()[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <std::size_t Size, typename T>
+bool operator!=(const Matrix<Size, T>& lhs, const Matrix<Size, T>& rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+
+template <std::size_t Size, typename T>
+Matrix<Size, T> transpose(const Matrix<Size, T>& m) noexcept
+{
+    Matrix<Size, T> res;
+    for (std::size_t i = 0; i < Size; ++i)
+    {
+        for (std::size_t j = 0; j < Size; ++j)
+        {
+            res(j, i) = m(i, j);
+        }
+    }
+    return res;
+}
+
+namespace detail
+{
+
+/**
+ *  Index of the row at or below column with the largest
+ *  absolute value in column.
+ */
+template <std::size_t Size, typename T>
+std::size_t find_pivot(const Matrix<Size, T>& m, std::size_t column) noexcept
+{
+    auto pivot = column;
+    for (std::size_t i = column + 1; i < Size; ++i)
+    {
+        if (std::abs(m(i, column)) > std::abs(m(pivot, column)))
+        {
+            pivot = i;
+        }
+    }
+    return pivot;
+}
+
+template <std::size_t Size, typename T>
+void swap_rows(Matrix<Size, T>& m, std::size_t a, std::size_t b) noexcept
+{
+    for (std::size_t j = 0; j < Size; ++j)
+    {
+        std::swap(m(a, j), m(b, j));
+    }
+}
+
+} // namespace detail
+
+template <std::size_t Size, typename T>
+T determinant(const Matrix<Size, T>& m) noexcept
+{
+    // Gaussian elimination with partial pivoting.
+    auto lu = m;
+    T res = T(1);
+
+    for (std::size_t k = 0; k < Size; ++k)
+    {
+        const auto pivot = detail::find_pivot(lu, k);
+
+        if (lu(pivot, k) == T(0))
+        {
+            return T(0);
+        }
+
+        if (pivot != k)
+        {
+            detail::swap_rows(lu, pivot, k);
+            res = -res;
+        }
+
+        res *= lu(k, k);
+
+        for (std::size_t i = k + 1; i < Size; ++i)
+        {
+            const auto factor = lu(i, k) / lu(k, k);
+            for (std::size_t j = k; j < Size; ++j)
+            {
+                lu(i, j) -= factor * lu(k, j);
+            }
+        }
+    }
+
+    return res;
+}
+
+template <std::size_t Size, typename T>
+Matrix<Size, T> inverse(const Matrix<Size, T>& m)
+{
+    // Gauss-Jordan elimination with partial pivoting, applying
+    // the same row operations to the identity.
+    auto lhs = m;
+    auto res = Matrix<Size, T>::identity();
+
+    for (std::size_t k = 0; k < Size; ++k)
+    {
+        const auto pivot = detail::find_pivot(lhs, k);
+
+        if (lhs(pivot, k) == T(0))
+        {
+            throw std::domain_error("Matrix is singular.");
+        }
+
+        detail::swap_rows(lhs, pivot, k);
+        detail::swap_rows(res, pivot, k);
+
+        const auto scale = T(1) / lhs(k, k);
+        for (std::size_t j = 0; j < Size; ++j)
+        {
+            lhs(k, j) *= scale;
+            res(k, j) *= scale;
+        }
+
+        for (std::size_t i = 0; i < Size; ++i)
+        {
+            if (i == k)
+            {
+                continue;
+            }
+
+            const auto factor = lhs(i, k);
+            for (std::size_t j = 0; j < Size; ++j)
+            {
+                lhs(i, j) -= factor * lhs(k, j);
+                res(i, j) -= factor * res(k, j);
+            }
+        }
+    }
+
+    return res;
+}
+
+template <typename T>
+Matrix4<T> make_affine(const Matrix3<T>& linear, const Vector3<T>& translation) noexcept
+{
+    auto res = Matrix4<T>::identity();
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        for (std::size_t j = 0; j < 3; ++j)
+        {
+            res(i, j) = linear(i, j);
+        }
+        res(i, 3) = translation[i];
+    }
+    return res;
+}
+
+template <typename T>
+Vector3<T> transform_point(const Matrix4<T>& m, const Vector3<T>& p) noexcept
+{
+    return Vector3<T>(
+        m(0, 0) * p[0] + m(0, 1) * p[1] + m(0, 2) * p[2] + m(0, 3),
+        m(1, 0) * p[0] + m(1, 1) * p[1] + m(1, 2) * p[2] + m(1, 3),
+        m(2, 0) * p[0] + m(2, 1) * p[1] + m(2, 2) * p[2] + m(2, 3));
+}
+
+template <typename T>
+Vector3<T> transform_direction(const Matrix4<T>& m, const Vector3<T>& d) noexcept
+{
+    return Vector3<T>(
+        m(0, 0) * d[0] + m(0, 1) * d[1] + m(0, 2) * d[2],
+        m(1, 0) * d[0] + m(1, 1) * d[1] + m(1, 2) * d[2],
+        m(2, 0) * d[0] + m(2, 1) * d[1] + m(2, 2) * d[2]);
+}
+
+template <typename T>
+void transform_points(const Matrix4<T>& m, const std::vector<Vector3<T>>& points, std::vector<Vector3<T>>& out)
+{
+    out.resize(points.size(), Vector3<T>(T(0), T(0), T(0)));
+
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        out[i] = transform_point(m, points[i]);
+    }
+}
+
+template <typename T>
+void transform_points(const Matrix4<T>& m, const VectorStream3<T>& points, VectorStream3<T>& out)
+{
+    const std::array<Vector3<T>, 3> rows {
+        Vector3<T>(m(0, 0), m(0, 1), m(0, 2)),
+        Vector3<T>(m(1, 0), m(1, 1), m(1, 2)),
+        Vector3<T>(m(2, 0), m(2, 1), m(2, 2))};
+
+    transform(points, rows, Vector3<T>(m(0, 3), m(1, 3), m(2, 3)), out);
+}
+
+#ifdef MORPH_VECTOR_SSE
+
+//
+//  SSE implementation of Matrix4f, each row is a register.
+//
+//  Non-template overloads, preferred over the generic templates. The
+//  generic versions stay reachable with explicit template arguments,
+//  e.g. inverse<4, float>(m).
+//
+
+namespace detail
+{
+
+inline __m128 sse_load_row(const Matrix4f& m, std::size_t row) noexcept
+{
+    return _mm_load_ps(m.data() + row * 4);
+}
+
+inline void sse_store_row(Matrix4f& m, std::size_t row, __m128 v) noexcept
+{
+    _mm_store_ps(m.data() + row * 4, v);
+}
+
+/**
+ *  Four points stored as x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3
+ *  to x0 x1 x2 x3 | y0 y1 y2 y3 | z0 z1 z2 z3, and back.
+ */
+inline void sse_deinterleave3(__m128 a, __m128 b, __m128 c, __m128& x, __m128& y, __m128& z) noexcept
+{
+    const auto b2_c1 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 0, 3, 2));
+    x = _mm_shuffle_ps(a, b2_c1, _MM_SHUFFLE(3, 0, 3, 0));
+
+    const auto a1_b0 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1));
+    const auto b3_c2 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3));
+    y = _mm_shuffle_ps(a1_b0, b3_c2, _MM_SHUFFLE(2, 0, 2, 0));
+
+    const auto a2_b1 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2));
+    const auto c0_c3 = _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0));
+    z = _mm_shuffle_ps(a2_b1, c0_c3, _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+inline void sse_interleave3(__m128 x, __m128 y, __m128 z, __m128& a, __m128& b, __m128& c) noexcept
+{
+    const auto xy_low = _mm_unpacklo_ps(x, y);
+    const auto xy_high = _mm_unpackhi_ps(x, y);
+
+    const auto z0_x1 = _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0));
+    a = _mm_shuffle_ps(xy_low, z0_x1, _MM_SHUFFLE(2, 0, 1, 0));
+
+    const auto y1_z1 = _mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1));
+    b = _mm_shuffle_ps(y1_z1, xy_high, _MM_SHUFFLE(1, 0, 2, 0));
+
+    const auto z2_z3_x3_y3 = _mm_shuffle_ps(z, xy_high, _MM_SHUFFLE(3, 2, 3, 2));
+    c = _mm_shuffle_ps(z2_z3_x3_y3, z2_z3_x3_y3, _MM_SHUFFLE(1, 3, 2, 0));
+}
+
+/**
+ *  The six 2x2 minors m_ij = p[i] q[j] - q[i] p[j] of the rows p and q,
+ *  as (m_23, m_23, m_13, m_12), (m_13, m_03, m_03, m_02) and
+ *  (m_12, m_02, m_01, m_01).
+ */
+struct SseMinors
+{
+    static constexpr int first = _MM_SHUFFLE(0, 0, 0, 1);
+    static constexpr int second = _MM_SHUFFLE(1, 1, 2, 2);
+    static constexpr int third = _MM_SHUFFLE(2, 3, 3, 3);
+
+    SseMinors(__m128 p, __m128 q) noexcept
+    {
+        const auto p0 = _mm_shuffle_ps(p, p, first);
+        const auto p1 = _mm_shuffle_ps(p, p, second);
+        const auto p2 = _mm_shuffle_ps(p, p, third);
+        const auto q0 = _mm_shuffle_ps(q, q, first);
+        const auto q1 = _mm_shuffle_ps(q, q, second);
+        const auto q2 = _mm_shuffle_ps(q, q, third);
+
+        m_12 = _mm_sub_ps(_mm_mul_ps(p1, q2), _mm_mul_ps(q1, p2));
+        m_02 = _mm_sub_ps(_mm_mul_ps(p0, q2), _mm_mul_ps(q0, p2));
+        m_01 = _mm_sub_ps(_mm_mul_ps(p0, q1), _mm_mul_ps(q0, p1));
+    }
+
+    /**
+     *  Column of the adjugate: cofactors of the row r complementing
+     *  the rows p and q, up to the sign of the column.
+     */
+    __m128 cofactors(__m128 r) const noexcept
+    {
+        const auto terms = _mm_add_ps(
+            _mm_sub_ps(
+                _mm_mul_ps(_mm_shuffle_ps(r, r, first), m_12),
+                _mm_mul_ps(_mm_shuffle_ps(r, r, second), m_02)),
+            _mm_mul_ps(_mm_shuffle_ps(r, r, third), m_01));
+
+        return _mm_xor_ps(terms, _mm_setr_ps(0.0f, -0.0f, 0.0f, -0.0f));
+    }
+
+    __m128 m_12;
+    __m128 m_02;
+    __m128 m_01;
+};
+
+} // namespace detail
+
+inline Matrix4f operator*(const Matrix4f& lhs, const Matrix4f& rhs) noexcept
+{
+    const __m128 rhs_rows[] = {
+        detail::sse_load_row(rhs, 0),
+        detail::sse_load_row(rhs, 1),
+        detail::sse_load_row(rhs, 2),
+        detail::sse_load_row(rhs, 3)};
+
+    Matrix4f res;
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        // Row i of the result combines the rows of rhs.
+        const auto l = detail::sse_load_row(lhs, i);
+
+        const auto row = _mm_add_ps(
+            _mm_add_ps(
+                _mm_mul_ps(_mm_shuffle_ps(l, l, _MM_SHUFFLE(0, 0, 0, 0)), rhs_rows[0]),
+                _mm_mul_ps(_mm_shuffle_ps(l, l, _MM_SHUFFLE(1, 1, 1, 1)), rhs_rows[1])),
+            _mm_add_ps(
+                _mm_mul_ps(_mm_shuffle_ps(l, l, _MM_SHUFFLE(2, 2, 2, 2)), rhs_rows[2]),
+                _mm_mul_ps(_mm_shuffle_ps(l, l, _MM_SHUFFLE(3, 3, 3, 3)), rhs_rows[3])));
+
+        detail::sse_store_row(res, i, row);
+    }
+    return res;
+}
+
+inline Vector4f operator*(const Matrix4f& lhs, const Vector4f& rhs) noexcept
+{
+    const auto v = detail::sse_load(rhs);
+
+    auto p0 = _mm_mul_ps(detail::sse_load_row(lhs, 0), v);
+    auto p1 = _mm_mul_ps(detail::sse_load_row(lhs, 1), v);
+    auto p2 = _mm_mul_ps(detail::sse_load_row(lhs, 2), v);
+    auto p3 = _mm_mul_ps(detail::sse_load_row(lhs, 3), v);
+
+    // Lane i of the sum is the dot product of row i and rhs.
+    _MM_TRANSPOSE4_PS(p0, p1, p2, p3);
+
+    return detail::sse_store<Vector4f>(_mm_add_ps(_mm_add_ps(p0, p1), _mm_add_ps(p2, p3)));
+}
+
+inline Matrix4f inverse(const Matrix4f& m)
+{
+    // Adjugate from the 2x2 minors of rows 0 and 1 and of rows 2 and 3,
+    // one column per register (Laplace expansion by complementary minors).
+    const auto row0 = detail::sse_load_row(m, 0);
+    const auto row1 = detail::sse_load_row(m, 1);
+    const auto row2 = detail::sse_load_row(m, 2);
+    const auto row3 = detail::sse_load_row(m, 3);
+
+    const auto low_minors = detail::SseMinors(row2, row3);
+    const auto high_minors = detail::SseMinors(row0, row1);
+
+    const auto sign = detail::sse_sign_mask();
+
+    auto col0 = low_minors.cofactors(row1);
+    auto col1 = _mm_xor_ps(low_minors.cofactors(row0), sign);
+    auto col2 = high_minors.cofactors(row3);
+    auto col3 = _mm_xor_ps(high_minors.cofactors(row2), sign);
+
+    const auto det = detail::sse_horizontal_sum(_mm_mul_ps(row0, col0));
+
+    if (det == 0.0f)
+    {
+        throw std::domain_error("Matrix is singular.");
+    }
+
+    const auto scale = _mm_set1_ps(1.0f / det);
+
+    _MM_TRANSPOSE4_PS(col0, col1, col2, col3);
+
+    Matrix4f res;
+    detail::sse_store_row(res, 0, _mm_mul_ps(col0, scale));
+    detail::sse_store_row(res, 1, _mm_mul_ps(col1, scale));
+    detail::sse_store_row(res, 2, _mm_mul_ps(col2, scale));
+    detail::sse_store_row(res, 3, _mm_mul_ps(col3, scale));
+    return res;
+}
+
+inline void transform_points(const Matrix4f& m, const std::vector<Vector3f>& points, std::vector<Vector3f>& out)
+{
+    out.resize(points.size(), Vector3f(0.0f, 0.0f, 0.0f));
+
+    std::size_t i = 0;
+
+#ifdef MORPH_PADDED_VECTOR3
+    // Each point is a register, combine the columns of m.
+    auto c0 = detail::sse_load_row(m, 0);
+    auto c1 = detail::sse_load_row(m, 1);
+    auto c2 = detail::sse_load_row(m, 2);
+    auto c3 = detail::sse_load_row(m, 3);
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+    const auto mask = detail::sse_xyz_mask();
+    c3 = _mm_and_ps(c3, mask);
+
+    for (; i < points.size(); ++i)
+    {
+        const auto p = detail::sse_load(points[i]);
+
+        auto r = _mm_add_ps(c3, _mm_mul_ps(c0, _mm_shuffle_ps(p, p, _MM_SHUFFLE(0, 0, 0, 0))));
+        r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_shuffle_ps(p, p, _MM_SHUFFLE(1, 1, 1, 1))));
+        r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 2, 2))));
+
+        out[i] = detail::sse_store<Vector3f>(_mm_and_ps(r, mask));
+    }
+#else
+    // Four packed points at a time, as x, y and z registers.
+    static_assert(sizeof(Vector3f) == 3 * sizeof(float), "Vector3f is packed.");
+
+    const auto in_data = reinterpret_cast<const float*>(points.data());
+    const auto out_data = reinterpret_cast<float*>(out.data());
+
+    __m128 e[3][4];
+    for (std::size_t r = 0; r < 3; ++r)
+    {
+        for (std::size_t c = 0; c < 4; ++c)
+        {
+            e[r][c] = _mm_set1_ps(m(r, c));
+        }
+    }
+
+    for (; i + 4 <= points.size(); i += 4)
+    {
+        __m128 x, y, z;
+        detail::sse_deinterleave3(
+            _mm_loadu_ps(in_data + i * 3),
+            _mm_loadu_ps(in_data + i * 3 + 4),
+            _mm_loadu_ps(in_data + i * 3 + 8),
+            x, y, z);
+
+        __m128 res[3];
+        for (std::size_t r = 0; r < 3; ++r)
+        {
+            res[r] = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(e[r][0], x), _mm_mul_ps(e[r][1], y)),
+                _mm_add_ps(_mm_mul_ps(e[r][2], z), e[r][3]));
+        }
+
+        __m128 a, b, c;
+        detail::sse_interleave3(res[0], res[1], res[2], a, b, c);
+
+        _mm_storeu_ps(out_data + i * 3, a);
+        _mm_storeu_ps(out_data + i * 3 + 4, b);
+        _mm_storeu_ps(out_data + i * 3 + 8, c);
+    }
+
+    for (; i < points.size(); ++i)
+    {
+        out[i] = transform_point(m, points[i]);
+    }
+#endif
+}
+
+//
+//  SSE implementation of Matrix3f. Rows are packed, each is loaded
+//  into a register with the last lane cleared.
+//
+
+namespace detail
+{
+
+inline void sse_load_rows(const Matrix3f& m, __m128& row0, __m128& row1, __m128& row2) noexcept
+{
+    // m0 m1 m2 m3 | m4 m5 m6 m7 | m8, no load reads past the matrix.
+    const auto a = _mm_loadu_ps(m.data());
+    const auto b = _mm_loadu_ps(m.data() + 4);
+    const auto c = _mm_load_ss(m.data() + 8);
+
+    const auto m3_m4 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 3, 3));
+    const auto mask = sse_xyz_mask();
+
+    row0 = _mm_and_ps(a, mask);
+    row1 = _mm_and_ps(_mm_shuffle_ps(m3_m4, b, _MM_SHUFFLE(3, 1, 2, 0)), mask);
+    row2 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 0, 3, 2));
+}
+
+inline void sse_store_rows(Matrix3f& m, __m128 row0, __m128 row1, __m128 row2) noexcept
+{
+    const auto z0_x1 = _mm_shuffle_ps(row0, row1, _MM_SHUFFLE(0, 0, 2, 2));
+
+    _mm_storeu_ps(m.data(), _mm_shuffle_ps(row0, z0_x1, _MM_SHUFFLE(2, 0, 1, 0)));
+    _mm_storeu_ps(m.data() + 4, _mm_shuffle_ps(row1, row2, _MM_SHUFFLE(1, 0, 2, 1)));
+    _mm_store_ss(m.data() + 8, _mm_movehl_ps(row2, row2));
+}
+
+inline Vector3f sse_store_vector3(__m128 v) noexcept
+{
+#ifdef MORPH_PADDED_VECTOR3
+    return sse_store<Vector3f>(v);
+#else
+    alignas(16) float res[4];
+    _mm_store_ps(res, v);
+
+    return Vector3f(res[0], res[1], res[2]);
+#endif
+}
+
+} // namespace detail
+
+inline Matrix3f operator*(const Matrix3f& lhs, const Matrix3f& rhs) noexcept
+{
+    __m128 rhs_rows[3];
+    detail::sse_load_rows(rhs, rhs_rows[0], rhs_rows[1], rhs_rows[2]);
+
+    __m128 lhs_rows[3];
+    detail::sse_load_rows(lhs, lhs_rows[0], lhs_rows[1], lhs_rows[2]);
+
+    __m128 res_rows[3];
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        // Row i of the result combines the rows of rhs.
+        const auto l = lhs_rows[i];
+
+        res_rows[i] = _mm_add_ps(
+            _mm_add_ps(
+                _mm_mul_ps(_mm_shuffle_ps(l, l, _MM_SHUFFLE(0, 0, 0, 0)), rhs_rows[0]),
+                _mm_mul_ps(_mm_shuffle_ps(l, l, _MM_SHUFFLE(1, 1, 1, 1)), rhs_rows[1])),
+            _mm_mul_ps(_mm_shuffle_ps(l, l, _MM_SHUFFLE(2, 2, 2, 2)), rhs_rows[2]));
+    }
+
+    Matrix3f res;
+    detail::sse_store_rows(res, res_rows[0], res_rows[1], res_rows[2]);
+    return res;
+}
+
+inline Vector3f operator*(const Matrix3f& lhs, const Vector3f& rhs) noexcept
+{
+    __m128 c0, c1, c2;
+    detail::sse_load_rows(lhs, c0, c1, c2);
+
+    auto c3 = _mm_setzero_ps();
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+    // Combine the columns of lhs.
+    const auto res = _mm_add_ps(
+        _mm_add_ps(
+            _mm_mul_ps(c0, _mm_set1_ps(rhs[0])),
+            _mm_mul_ps(c1, _mm_set1_ps(rhs[1]))),
+        _mm_mul_ps(c2, _mm_set1_ps(rhs[2])));
+
+    return detail::sse_store_vector3(res);
+}
+
+inline Matrix3f inverse(const Matrix3f& m)
+{
+    // Columns of the adjugate are the cross products of the other rows.
+    __m128 row0, row1, row2;
+    detail::sse_load_rows(m, row0, row1, row2);
+
+    auto col0 = detail::sse_cross_product(row1, row2);
+    auto col1 = detail::sse_cross_product(row2, row0);
+    auto col2 = detail::sse_cross_product(row0, row1);
+
+    const auto det = detail::sse_horizontal_sum(_mm_mul_ps(row0, col0));
+
+    if (det == 0.0f)
+    {
+        throw std::domain_error("Matrix is singular.");
+    }
+
+    const auto scale = _mm_set1_ps(1.0f / det);
+
+    auto col3 = _mm_setzero_ps();
+    _MM_TRANSPOSE4_PS(col0, col1, col2, col3);
+
+    Matrix3f res;
+    detail::sse_store_rows(res, _mm_mul_ps(col0, scale), _mm_mul_ps(col1, scale), _mm_mul_ps(col2, scale));
+    return res;
+}
+
+#endif // MORPH_VECTOR_SSE
+
+} // namespace foundation
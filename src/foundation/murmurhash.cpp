@@ -1,6 +1,13 @@
 #include "foundation/murmurhash.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define MORPH_MURMURHASH_AVX2
+#include <immintrin.h>
+#endif
 
 namespace foundation
 {
@@ -8,115 +15,363 @@ namespace foundation
 namespace
 {
 
+constexpr std::size_t block_size = 16;
+
+constexpr std::uint64_t c1 = 0x87c37b91114253d5;
+constexpr std::uint64_t c2 = 0x4cf5ad432745937f;
+
 inline std::uint64_t rotl64(std::uint64_t x, std::int8_t r)
 {
     return (x << r) | (x >> (64 - r));
 }
 
-inline std::uint64_t fmix64(std::uint64_t k)
+// Unaligned safe, compiles to a plain load.
+inline std::uint64_t load64(const unsigned char* p)
+{
+    std::uint64_t result;
+    std::memcpy(&result, p, sizeof(result));
+
+    return result;
+}
+
+inline std::uint64_t mix_k1(std::uint64_t k1)
+{
+    k1 *= c1;
+    k1 = rotl64(k1, 31);
+    k1 *= c2;
+
+    return k1;
+}
+
+inline std::uint64_t mix_k2(std::uint64_t k2)
+{
+    k2 *= c2;
+    k2 = rotl64(k2, 33);
+    k2 *= c1;
+
+    return k2;
+}
+
+inline void mix_block(std::uint64_t& h1, std::uint64_t& h2, const unsigned char* block)
+{
+    h1 ^= mix_k1(load64(block));
+
+    h1 = rotl64(h1, 27);
+    h1 += h2;
+    h1 = h1 * 5 + 0x52dce729;
+
+    h2 ^= mix_k2(load64(block + 8));
+
+    h2 = rotl64(h2, 31);
+    h2 += h1;
+    h2 = h2 * 5 + 0x38495ab5;
+}
+
+/**
+ *  Mix in the last tail_size < 16 bytes and finalize.
+ */
+inline std::pair<std::uint64_t, std::uint64_t> finalize(
+    std::uint64_t           h1,
+    std::uint64_t           h2,
+    const unsigned char*    tail,
+    std::size_t             tail_size,
+    std::uint64_t           length)
+{
+    unsigned char block[block_size] = {};
+    std::memcpy(block, tail, tail_size);
+
+    if (tail_size > 8)
+    {
+        h2 ^= mix_k2(load64(block + 8));
+    }
+
+    if (tail_size > 0)
+    {
+        h1 ^= mix_k1(load64(block));
+    }
+
+    h1 ^= length;
+    h2 ^= length;
+
+    h1 += h2;
+    h2 += h1;
+
+    h1 = fmix64(h1);
+    h2 = fmix64(h2);
+
+    h1 += h2;
+    h2 += h1;
+
+    return {h1, h2};
+}
+
+inline std::size_t combine(std::uint64_t h1, std::uint64_t h2)
+{
+    return h1 ^ (h2 + 0x9e3779b9 + (h1 << 6) + (h1 >> 2));
+}
+
+std::size_t hash_one(std::string_view input)
 {
-    k ^= k >> 33;
-    k *= 0xff51afd7ed558ccd;
-    k ^= k >> 33;
-    k *= 0xc4ceb9fe1a85ec53;
-    k ^= k >> 33;
+    auto data = reinterpret_cast<const unsigned char*>(input.data());
+    const auto last_block = data + (input.size() & ~(block_size - 1));
+
+    std::uint64_t h1 = 0u;
+    std::uint64_t h2 = 0u;
+
+    for (; data != last_block; data += block_size)
+    {
+        mix_block(h1, h2, data);
+    }
+
+    const auto [f1, f2] = finalize(h1, h2, data, input.size() & (block_size - 1), input.size());
+
+    return combine(f1, f2);
+}
+
+void hash_batch_scalar(const std::string_view* inputs, std::size_t count, std::size_t* hashes)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        hashes[i] = hash_one(inputs[i]);
+    }
+}
+
+#ifdef MORPH_MURMURHASH_AVX2
+
+//
+// Four inputs of the same size per vector, one per 64 bit lane.
+//
+
+#define MORPH_AVX2 __attribute__((target("avx2")))
+
+// AVX2 has no 64 bit multiplication, build it from 32 bit ones.
+MORPH_AVX2 inline __m256i mul64(__m256i a, std::uint64_t c)
+{
+    const auto c_lo = _mm256_set1_epi64x(static_cast<long long>(c & 0xffffffffu));
+    const auto c_hi = _mm256_set1_epi64x(static_cast<long long>(c >> 32));
+
+    const auto lo = _mm256_mul_epu32(a, c_lo);
+    const auto cross = _mm256_add_epi64(
+        _mm256_mul_epu32(_mm256_srli_epi64(a, 32), c_lo),
+        _mm256_mul_epu32(a, c_hi));
+
+    return _mm256_add_epi64(lo, _mm256_slli_epi64(cross, 32));
+}
+
+template <int R>
+MORPH_AVX2 inline __m256i rotl64x4(__m256i x)
+{
+    return _mm256_or_si256(_mm256_slli_epi64(x, R), _mm256_srli_epi64(x, 64 - R));
+}
+
+MORPH_AVX2 inline __m256i mix_k1x4(__m256i k1)
+{
+    return mul64(rotl64x4<31>(mul64(k1, c1)), c2);
+}
+
+MORPH_AVX2 inline __m256i mix_k2x4(__m256i k2)
+{
+    return mul64(rotl64x4<33>(mul64(k2, c2)), c1);
+}
+
+// x * 5 + c
+MORPH_AVX2 inline __m256i mul5_add(__m256i x, std::uint64_t c)
+{
+    return _mm256_add_epi64(
+        _mm256_add_epi64(_mm256_slli_epi64(x, 2), x),
+        _mm256_set1_epi64x(static_cast<long long>(c)));
+}
+
+MORPH_AVX2 inline __m256i fmix64x4(__m256i k)
+{
+    k = _mm256_xor_si256(k, _mm256_srli_epi64(k, 33));
+    k = mul64(k, 0xff51afd7ed558ccd);
+    k = _mm256_xor_si256(k, _mm256_srli_epi64(k, 33));
+    k = mul64(k, 0xc4ceb9fe1a85ec53);
+    k = _mm256_xor_si256(k, _mm256_srli_epi64(k, 33));
 
     return k;
 }
 
+MORPH_AVX2 inline __m256i load64x4(const unsigned char* const* data, std::size_t offset)
+{
+    return _mm256_set_epi64x(
+        static_cast<long long>(load64(data[3] + offset)),
+        static_cast<long long>(load64(data[2] + offset)),
+        static_cast<long long>(load64(data[1] + offset)),
+        static_cast<long long>(load64(data[0] + offset)));
+}
+
+MORPH_AVX2 void hash4_avx2(const std::string_view* inputs, std::size_t* hashes)
+{
+    const auto size = inputs[0].size();
+    const auto body_size = size & ~(block_size - 1);
+    const auto tail_size = size & (block_size - 1);
+
+    const unsigned char* data[4];
+
+    for (int lane = 0; lane < 4; ++lane)
+    {
+        data[lane] = reinterpret_cast<const unsigned char*>(inputs[lane].data());
+    }
+
+    auto h1 = _mm256_setzero_si256();
+    auto h2 = _mm256_setzero_si256();
+
+    for (std::size_t offset = 0; offset != body_size; offset += block_size)
+    {
+        h1 = _mm256_xor_si256(h1, mix_k1x4(load64x4(data, offset)));
+        h1 = mul5_add(_mm256_add_epi64(rotl64x4<27>(h1), h2), 0x52dce729);
+
+        h2 = _mm256_xor_si256(h2, mix_k2x4(load64x4(data, offset + 8)));
+        h2 = mul5_add(_mm256_add_epi64(rotl64x4<31>(h2), h1), 0x38495ab5);
+    }
+
+    if (tail_size != 0)
+    {
+        unsigned char tails[4][block_size] = {};
+        const unsigned char* tail_data[4];
+
+        for (int lane = 0; lane < 4; ++lane)
+        {
+            std::memcpy(tails[lane], data[lane] + body_size, tail_size);
+            tail_data[lane] = tails[lane];
+        }
+
+        if (tail_size > 8)
+        {
+            h2 = _mm256_xor_si256(h2, mix_k2x4(load64x4(tail_data, 8)));
+        }
+
+        h1 = _mm256_xor_si256(h1, mix_k1x4(load64x4(tail_data, 0)));
+    }
+
+    const auto length = _mm256_set1_epi64x(static_cast<long long>(size));
+
+    h1 = _mm256_xor_si256(h1, length);
+    h2 = _mm256_xor_si256(h2, length);
+
+    h1 = _mm256_add_epi64(h1, h2);
+    h2 = _mm256_add_epi64(h2, h1);
+
+    h1 = fmix64x4(h1);
+    h2 = fmix64x4(h2);
+
+    h1 = _mm256_add_epi64(h1, h2);
+    h2 = _mm256_add_epi64(h2, h1);
+
+    // combine()
+    const auto sum = _mm256_add_epi64(
+        _mm256_add_epi64(h2, _mm256_set1_epi64x(0x9e3779b9)),
+        _mm256_add_epi64(_mm256_slli_epi64(h1, 6), _mm256_srli_epi64(h1, 2)));
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(hashes), _mm256_xor_si256(h1, sum));
+}
+
+void hash_batch_avx2(const std::string_view* inputs, std::size_t count, std::size_t* hashes)
+{
+    std::size_t i = 0;
+
+    for (; i + 4 <= count; i += 4)
+    {
+        const auto size = inputs[i].size();
+
+        if (inputs[i + 1].size() == size &&
+            inputs[i + 2].size() == size &&
+            inputs[i + 3].size() == size)
+        {
+            hash4_avx2(inputs + i, hashes + i);
+        }
+        else
+        {
+            hash_batch_scalar(inputs + i, 4, hashes + i);
+        }
+    }
+
+    hash_batch_scalar(inputs + i, count - i, hashes + i);
+}
+
+#undef MORPH_AVX2
+
+#endif // MORPH_MURMURHASH_AVX2
+
+using HashBatchFn = void (*)(const std::string_view*, std::size_t, std::size_t*);
+
+HashBatchFn select_hash_batch()
+{
+#ifdef MORPH_MURMURHASH_AVX2
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return &hash_batch_avx2;
+    }
+#endif
+
+    return &hash_batch_scalar;
+}
+
 } // namespace
 
 MurmurHash::MurmurHash() noexcept
     : m_h1(0u)
     , m_h2(0u)
+    , m_length(0u)
+    , m_carry_size(0u)
 {}
 
 void MurmurHash::append(const void* payload, std::size_t len) noexcept
 {
-    const std::uint8_t* data = reinterpret_cast<const std::uint8_t*>(payload);
-    const std::size_t nblocks = len / 16;
+    const unsigned char* data = static_cast<const unsigned char*>(payload);
 
-    constexpr uint64_t c1 = 0x87c37b91114253d5;
-    constexpr uint64_t c2 = 0x4cf5ad432745937f;
-
-    // Body.
-    const std::uint64_t* blocks = reinterpret_cast<const std::uint64_t*>(data);
+    m_length += len;
 
-    for(std::size_t i = 0; i < nblocks; ++i)
+    // Complete the carried block first.
+    if (m_carry_size != 0)
     {
-        std::uint64_t k1 = blocks[i * 2];
-        std::uint64_t k2 = blocks[i * 2 + 1];
-
-        k1 *= c1;
-        k1 = rotl64(k1, 31);
-        k1 *= c2;
-        m_h1 ^= k1;
-
-        m_h1 = rotl64(m_h1, 27);
-        m_h1 += m_h2;
-        m_h1 = m_h1 * 5 + 0x52dce729;
-
-        k2 *= c2;
-        k2 = rotl64(k2, 33);
-        k2 *= c1;
-        m_h2 ^= k2;
-
-        m_h2 = rotl64(m_h2, 31);
-        m_h2 += m_h1;
-        m_h2 *= 5 + 0x38495ab5;
-    }
+        const auto n = std::min(len, block_size - m_carry_size);
+
+        std::memcpy(m_carry + m_carry_size, data, n);
+        m_carry_size += n;
+        data += n;
+        len -= n;
 
-    // Tail.
-    const std::uint8_t* tail = data + nblocks * 16;
+        if (m_carry_size < block_size)
+        {
+            return;
+        }
 
-    std::uint64_t k1 = 0;
-    std::uint64_t k2 = 0;
+        mix_block(m_h1, m_h2, m_carry);
+        m_carry_size = 0;
+    }
 
-    switch(len & 15)
+    // Body.
+    for (; len >= block_size; data += block_size, len -= block_size)
     {
-        case 15: k2 ^= (static_cast<std::uint64_t>(tail[14])) << 48;
-        case 14: k2 ^= (static_cast<std::uint64_t>(tail[13])) << 40;
-        case 13: k2 ^= (static_cast<std::uint64_t>(tail[12])) << 32;
-        case 12: k2 ^= (static_cast<std::uint64_t>(tail[11])) << 24;
-        case 11: k2 ^= (static_cast<std::uint64_t>(tail[10])) << 16;
-        case 10: k2 ^= (static_cast<std::uint64_t>(tail[ 9])) << 8;
-        case  9: k2 ^= (static_cast<std::uint64_t>(tail[ 8])) << 0;
-                    k2 *= c2;
-                    k2 = rotl64(k2, 33);
-                    k2 *= c1;
-                    m_h2 ^= k2;
-
-        case  8: k1 ^= (static_cast<std::uint64_t>(tail[ 7])) << 56;
-        case  7: k1 ^= (static_cast<std::uint64_t>(tail[ 6])) << 48;
-        case  6: k1 ^= (static_cast<std::uint64_t>(tail[ 5])) << 40;
-        case  5: k1 ^= (static_cast<std::uint64_t>(tail[ 4])) << 32;
-        case  4: k1 ^= (static_cast<std::uint64_t>(tail[ 3])) << 24;
-        case  3: k1 ^= (static_cast<std::uint64_t>(tail[ 2])) << 16;
-        case  2: k1 ^= (static_cast<std::uint64_t>(tail[ 1])) << 8;
-        case  1: k1 ^= (static_cast<std::uint64_t>(tail[ 0])) << 0;
-                    k1 *= c1;
-                    k1 = rotl64(k1, 31);
-                    k1 *= c2;
-                    m_h1 ^= k1;
-    };
-
-    // Finalize.
-    m_h1 ^= len;
-    m_h2 ^= len;
-
-    m_h1 += m_h2;
-    m_h2 += m_h1;
-
-    m_h1 = fmix64(m_h1);
-    m_h2 = fmix64(m_h2);
-
-    m_h1 += m_h2;
-    m_h2 += m_h1;
+        mix_block(m_h1, m_h2, data);
+    }
+
+    // Carry the tail to the next append.
+    std::memcpy(m_carry, data, len);
+    m_carry_size = len;
+}
+
+std::pair<std::uint64_t, std::uint64_t> MurmurHash::as_128bit() const noexcept
+{
+    return finalize(m_h1, m_h2, m_carry, m_carry_size, m_length);
 }
 
 std::size_t MurmurHash::as_64bit() const noexcept
 {
-    return m_h1 ^ (m_h2 + 0x9e3779b9 + (m_h1 << 6) + (m_h1 >> 2));
+    const auto [h1, h2] = as_128bit();
+    return combine(h1, h2);
+}
+
+void murmur_hash_batch(
+    const std::string_view* inputs,
+    std::size_t             count,
+    std::size_t*            hashes) noexcept
+{
+    static const auto hash_batch = select_hash_batch();
+    hash_batch(inputs, count, hashes);
 }
 
 } // namespace foundation
@@ -2,6 +2,11 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 
 namespace foundation
 {
@@ -9,6 +14,10 @@ namespace foundation
 /**
  *  Based on SMHasher code.
  *  "All MurmurHash versions are public domain software, and the author disclaims all copyright to their code."
+ *
+ *  Streaming MurmurHash3_x64_128 with a zero seed: appending a message
+ *  in pieces gives the same hash as appending it at once. The bytes
+ *  not making a whole 16 bytes block yet are carried between appends.
  */
 class MurmurHash
 {
@@ -16,14 +25,67 @@ class MurmurHash
     MurmurHash() noexcept;
 
     void append(const void* payload, std::size_t len) noexcept;
-    
+
+    /**
+     *  Append the bytes of a trivially copyable value. Values that don't
+     *  complete a block are just copied into the carry buffer.
+     */
+    template <typename T>
+    void append_value(const T& value) noexcept
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Values are hashed as bytes.");
+
+        if (m_carry_size + sizeof(T) < block_size)
+        {
+            std::memcpy(m_carry + m_carry_size, &value, sizeof(T));
+            m_carry_size += sizeof(T);
+            m_length += sizeof(T);
+        }
+        else
+        {
+            append(&value, sizeof(T));
+        }
+    }
+
+    std::pair<std::uint64_t, std::uint64_t> as_128bit() const noexcept;
     std::size_t as_64bit() const noexcept;
 
   private:
-    std::uint64_t m_h1;
-    std::uint64_t m_h2;
+    static constexpr std::size_t block_size = 16;
+
+    std::uint64_t   m_h1;
+    std::uint64_t   m_h2;
+    std::uint64_t   m_length;
+    std::size_t     m_carry_size;
+    unsigned char   m_carry[block_size];
 };
 
+/**
+ *  Hash count independent inputs at once, hashes[i] being equal to
+ *  the as_64bit() of a MurmurHash of inputs[i].
+ *
+ *  Runs of four inputs of the same size are hashed in parallel with
+ *  AVX2 if the CPU supports it, other inputs one at a time.
+ */
+void murmur_hash_batch(
+    const std::string_view* inputs,
+    std::size_t             count,
+    std::size_t*            hashes) noexcept;
+
+/**
+ *  MurmurHash3 finalizer: every input bit affects every output bit.
+ */
+constexpr std::uint64_t fmix64(std::uint64_t k) noexcept
+{
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccd;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53;
+    k ^= k >> 33;
+
+    return k;
+}
+
 /**
  *  Hasher object allows using (murmur-)hashable classes
  *  as hash map keys.
@@ -37,4 +99,60 @@ struct Hasher
     }
 };
 
+template <typename T, typename = void>
+constexpr bool is_murmur_hashable = false;
+
+template <typename T>
+constexpr bool is_murmur_hashable<
+    T,
+    std::void_t<decltype(std::declval<const T&>().hash().as_64bit())>> = true;
+
+/**
+ *  Default hash of the immutable containers.
+ *
+ *  Integers and enums use std::hash, which is the integer itself with
+ *  libstdc++: dense ids fill the HAMT levels evenly and neighbouring ids
+ *  share their path, which mixing would only scatter. Pointers have
+ *  their low bits fixed by alignment, so they are mixed with fmix64.
+ *  Strings are hashed with MurmurHash, (murmur-)hashable classes use
+ *  their hash(), anything else falls back to std::hash.
+ */
+template <typename T>
+struct DefaultHasher
+{
+    std::size_t operator()(const T& value) const noexcept
+    {
+        if constexpr (std::is_integral_v<T>)
+        {
+            return std::hash<T> {}(value);
+        }
+        else if constexpr (std::is_enum_v<T>)
+        {
+            return DefaultHasher<std::underlying_type_t<T>> {}(
+                static_cast<std::underlying_type_t<T>>(value));
+        }
+        else if constexpr (std::is_pointer_v<T>)
+        {
+            return static_cast<std::size_t>(fmix64(reinterpret_cast<std::uintptr_t>(value)));
+        }
+        else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+        {
+            const std::string_view view = value;
+
+            MurmurHash hash;
+            hash.append(view.data(), view.size());
+
+            return hash.as_64bit();
+        }
+        else if constexpr (is_murmur_hashable<T>)
+        {
+            return Hasher<T> {}(value);
+        }
+        else
+        {
+            return std::hash<T> {}(value);
+        }
+    }
+};
+
 } // namespace foundation
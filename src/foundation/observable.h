@@ -1,24 +1,47 @@
 #pragma once
 
-#include "foundation/immutable/map.h"
+#include "foundation/atomicsnapshot.h"
+#include "foundation/subscriberlist.h"
+#include "foundation/taskqueue.h"
 
+#include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <exception>
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 
 namespace foundation
 {
 
+namespace detail
+{
+
+// Whether the values Ts bind to the const Params& of the subscribers.
+template <typename Params, typename Ts, typename = void>
+struct are_notify_arguments : std::false_type {};
+
+template <typename... Params, typename... Ts>
+struct are_notify_arguments<
+    std::tuple<Params...>,
+    std::tuple<Ts...>,
+    std::enable_if_t<sizeof...(Params) == sizeof...(Ts)>>
+  : std::conjunction<std::is_convertible<Ts&&, const Params&>...> {};
+
+} // namespace detail
+
 template <typename... Args>
 class Observable : public std::enable_shared_from_this<Observable<Args...>>
 {
   public:
-    using OnUpdateFn      = std::function<void(Args...)>;
+    using OnUpdateFn      = std::function<void(const Args&...)>;
     using SubscriptionKey = std::uint64_t;
-    using Subscribers     = foundation::immutable::Map<SubscriptionKey, OnUpdateFn>;
+    using Subscribers     = SubscriberList<SubscriptionKey, OnUpdateFn>;
 
     class Disposable
     {
@@ -43,27 +66,114 @@ class Observable : public std::enable_shared_from_this<Observable<Args...>>
 
     Observable()
       : m_next_subscription_key(0u)
+      , m_coalescing_queue(nullptr)
     {}
 
     Disposable subscribe(OnUpdateFn on_update) noexcept;
 
+    /**
+     *  Deliver notifications on the queue instead of on the notifying thread,
+     *  collapsing the ones issued before delivery into the latest one.
+     *  A notification is delivered at most max_latency after it's issued;
+     *  a longer latency collapses more notifications per delivery.
+     *
+     *  Requires the observable to be owned by a std::shared_ptr,
+     *  the queue must outlive the observable. Once the queue is shut down
+     *  notifications are delivered synchronously, a delivery it dropped
+     *  is superseded by the next notification.
+     */
+    void enable_coalescing(TaskQueue& queue, std::chrono::milliseconds max_latency = {});
+
+    /**
+     *  Deliver the next notifications synchronously again.
+     *  A pending notification is still delivered on the queue.
+     */
+    void disable_coalescing();
+
   protected:
-    void notify(Args... args) const;
+    /**
+     *  Subscribers get the arguments by reference, nothing is copied
+     *  unless the notification is coalesced, in which case rvalue
+     *  arguments are moved into the pending notification.
+     */
+    template <typename... Ts,
+              std::enable_if_t<detail::are_notify_arguments<std::tuple<Args...>, std::tuple<Ts...>>::value, int> = 0>
+    void notify(Ts&&... args) const
+    {
+        notify_impl(std::forward<Ts>(args)...);
+    }
+
     void unsubscribe(SubscriptionKey key);
 
   private:
-    SubscriptionKey     m_next_subscription_key;
-    Subscribers         m_subscribers;
-    mutable std::mutex  m_mutex;
+    using Arguments = std::tuple<std::decay_t<Args>...>;
+
+    /**
+     *  Delivery posted to the coalescing queue. If the queue drops it
+     *  without running it, the next notification schedules another.
+     */
+    struct ScheduledDelivery
+    {
+        explicit ScheduledDelivery(std::weak_ptr<const Observable> observable) noexcept
+          : m_observable(std::move(observable))
+        {}
+
+        ~ScheduledDelivery()
+        {
+            if (m_has_run)
+            {
+                return;
+            }
+
+            if (const auto observable = m_observable.lock())
+            {
+                std::lock_guard<std::mutex> lock(observable->m_mutex);
+                observable->m_is_scheduled = false;
+            }
+        }
+
+        void run()
+        {
+            m_has_run = true;
+
+            if (const auto observable = m_observable.lock())
+            {
+                observable->deliver_pending();
+            }
+        }
+
+        std::weak_ptr<const Observable> m_observable;
+        bool                            m_has_run = false;
+    };
+
+    template <typename... Ts>
+    void notify_impl(Ts&&... args) const;
+
+    static void deliver(const Subscribers& subscribers, const Args&... args);
+    void deliver_pending() const;
+
+    // Published atomically, so that notify() doesn't block.
+    std::atomic<SubscriptionKey>        m_next_subscription_key;
+    AtomicSnapshot<Subscribers>         m_subscribers;
+
+    // Coalescing, guarded by m_mutex.
+    std::atomic<TaskQueue*>             m_coalescing_queue;
+    std::chrono::milliseconds           m_max_latency {0};
+    mutable std::optional<Arguments>    m_pending;
+    mutable bool                        m_is_scheduled = false;
+    mutable std::mutex                  m_mutex;
 };
 
 template <typename... Args>
 typename Observable<Args...>::Disposable Observable<Args...>::subscribe(OnUpdateFn on_update) noexcept
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto key = m_next_subscription_key.fetch_add(1u, std::memory_order_relaxed);
 
-    auto key = m_next_subscription_key++;
-    m_subscribers = m_subscribers.set(key, std::move(on_update));
+    m_subscribers.update(
+        [key, &on_update](const Subscribers& subscribers)
+        {
+            return subscribers.insert(key, on_update);
+        });
 
     return Disposable(
         [thisWeakPtr = this->weak_from_this(), key]()
@@ -76,19 +186,103 @@ typename Observable<Args...>::Disposable Observable<Args...>::subscribe(OnUpdate
 }
 
 template <typename... Args>
-void Observable<Args...>::notify(Args... args) const
+void Observable<Args...>::enable_coalescing(TaskQueue& queue, std::chrono::milliseconds max_latency)
 {
-    Subscribers subscribers;
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_max_latency = max_latency;
+    m_coalescing_queue.store(&queue, std::memory_order_release);
+}
 
+template <typename... Args>
+void Observable<Args...>::disable_coalescing()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_coalescing_queue.store(nullptr, std::memory_order_release);
+}
+
+template <typename... Args>
+template <typename... Ts>
+void Observable<Args...>::notify_impl(Ts&&... args) const
+{
+    if (m_coalescing_queue.load(std::memory_order_acquire) == nullptr)
+    {
+        const auto subscribers = m_subscribers.load();
+        deliver(*subscribers, args...);
+
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    auto queue = m_coalescing_queue.load(std::memory_order_relaxed);
+
+    if (queue == nullptr)
+    {
+        // Disabled concurrently.
+        lock.unlock();
+        deliver(*m_subscribers.load(), args...);
+
+        return;
+    }
+
+    const bool is_scheduled = std::exchange(m_is_scheduled, true);
+    m_pending.emplace(std::forward<Ts>(args)...);
+
+    const auto max_latency = m_max_latency;
+
+    lock.unlock();
+
+    if (is_scheduled)
+    {
+        return;
+    }
+
+    const bool is_posted = queue->post_delayed(
+        [delivery = std::make_shared<ScheduledDelivery>(this->weak_from_this())]()
+        {
+            delivery->run();
+        },
+        max_latency);
+
+    if (!is_posted)
+    {
+        // The queue has been shut down.
+        deliver_pending();
+    }
+}
+
+template <typename... Args>
+void Observable<Args...>::deliver_pending() const
+{
     m_mutex.lock();
-    subscribers = m_subscribers;
+    auto pending = std::move(m_pending);
+    m_pending.reset();
+    m_is_scheduled = false;
     m_mutex.unlock();
 
+    if (pending)
+    {
+        const auto subscribers = m_subscribers.load();
+
+        // The pending copy is not shared, reference Args may bind to it.
+        std::apply(
+            [&subscribers](auto&... args)
+            {
+                deliver(*subscribers, args...);
+            },
+            *pending);
+    }
+}
+
+template <typename... Args>
+void Observable<Args...>::deliver(const Subscribers& subscribers, const Args&... args)
+{
     for (const auto& [i, f] : subscribers)
     {
         try
         {
-            f(args...);
+            (*f)(args...);
         }
         catch(const std::exception&)
         {
@@ -100,8 +294,11 @@ void Observable<Args...>::notify(Args... args) const
 template <typename... Args>
 void Observable<Args...>::unsubscribe(SubscriptionKey key)
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    m_subscribers = m_subscribers.erase(key);
+    m_subscribers.update(
+        [key](const Subscribers& subscribers)
+        {
+            return subscribers.erase(key);
+        });
 }
 
 } // namespace foundation
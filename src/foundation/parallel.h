@@ -0,0 +1,149 @@
+#pragma once
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+#include <tbb/parallel_sort.h>
+#include <tbb/partitioner.h>
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+
+namespace foundation
+{
+
+/**
+ *  Data-parallel helpers running on the TBB work-stealing scheduler.
+ *
+ *  grain_size is the number of iterations processed by a single task:
+ *  zero lets the scheduler pick chunk sizes adaptively, a non-zero value
+ *  splits the range into chunks of at most grain_size iterations.
+ */
+
+enum class ReductionOrder
+{
+    // Partial results are combined in whatever order tasks finish.
+    Any,
+
+    // The range is always split the same way and partial results are
+    // combined in the same order, so floating point results are
+    // reproducible from run to run regardless of the number of threads.
+    Deterministic
+};
+
+namespace detail
+{
+
+// Grain used for deterministic reductions when none is given:
+// they can't split adaptively, and splitting down to single
+// iterations would drown the work in scheduling overhead.
+constexpr std::size_t default_deterministic_grain_size = 1024u;
+
+} // namespace detail
+
+/**
+ *  Call fn(i) for every i in [begin, end).
+ */
+template <typename Index, typename Fn>
+void parallel_for(Index begin, Index end, Fn fn, std::size_t grain_size = 0u)
+{
+    if (!(begin < end))
+    {
+        return;
+    }
+
+    auto body = [&fn](const tbb::blocked_range<Index>& r)
+    {
+        for (Index i = r.begin(); i != r.end(); ++i)
+        {
+            fn(i);
+        }
+    };
+
+    if (grain_size == 0u)
+    {
+        tbb::parallel_for(tbb::blocked_range<Index>(begin, end), body, tbb::auto_partitioner());
+    }
+    else
+    {
+        tbb::parallel_for(tbb::blocked_range<Index>(begin, end, grain_size), body, tbb::simple_partitioner());
+    }
+}
+
+/**
+ *  Reduce [begin, end) into a single value.
+ *
+ *  range_fn(b, e, acc) accumulates iterations [b, e) into acc and returns it,
+ *  reduction(lhs, rhs) combines two partial results; identity must be
+ *  the neutral element of the reduction.
+ */
+template <typename Index, typename T, typename RangeFn, typename Reduction>
+T parallel_reduce(
+    Index           begin,
+    Index           end,
+    T               identity,
+    RangeFn         range_fn,
+    Reduction       reduction,
+    std::size_t     grain_size = 0u,
+    ReductionOrder  order = ReductionOrder::Any)
+{
+    if (!(begin < end))
+    {
+        return identity;
+    }
+
+    auto body = [&range_fn](const tbb::blocked_range<Index>& r, T acc)
+    {
+        return range_fn(r.begin(), r.end(), std::move(acc));
+    };
+
+    if (order == ReductionOrder::Deterministic)
+    {
+        if (grain_size == 0u)
+        {
+            grain_size = detail::default_deterministic_grain_size;
+        }
+
+        return tbb::parallel_deterministic_reduce(
+            tbb::blocked_range<Index>(begin, end, grain_size),
+            identity,
+            body,
+            reduction);
+    }
+
+    if (grain_size == 0u)
+    {
+        return tbb::parallel_reduce(
+            tbb::blocked_range<Index>(begin, end),
+            identity,
+            body,
+            reduction,
+            tbb::auto_partitioner());
+    }
+
+    return tbb::parallel_reduce(
+        tbb::blocked_range<Index>(begin, end, grain_size),
+        identity,
+        body,
+        reduction,
+        tbb::simple_partitioner());
+}
+
+/**
+ *  Sort [first, last) in parallel. The sort is not stable.
+ */
+template <typename RandomIt, typename Compare>
+void parallel_sort(RandomIt first, RandomIt last, Compare comp)
+{
+    tbb::parallel_sort(first, last, comp);
+}
+
+template <typename RandomIt>
+void parallel_sort(RandomIt first, RandomIt last)
+{
+    tbb::parallel_sort(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>());
+}
+
+} // namespace foundation
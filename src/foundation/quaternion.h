@@ -0,0 +1,284 @@
+#pragma once
+
+#include "foundation/matrix.h"
+#include "foundation/vector.h"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+namespace foundation
+{
+
+//
+// Quaternion declaration.
+//
+
+/**
+ *  Quaternion x i + y j + z k + w. Unit quaternions represent rotations,
+ *  q * r rotates by r, then by q.
+ */
+template <typename Element>
+class Quaternion
+{
+  public:
+    Quaternion(Element x, Element y, Element z, Element w);
+
+    static Quaternion identity() noexcept;
+
+    /**
+     *  Rotation by angle radians around the unit vector axis.
+     */
+    static Quaternion from_axis_angle(const Vector3<Element>& axis, Element angle) noexcept;
+
+    Element& operator[](const std::size_t i) noexcept;
+    const Element& operator[](const std::size_t i) const noexcept;
+
+    Element& x() noexcept;
+    const Element& x() const noexcept;
+
+    Element& y() noexcept;
+    const Element& y() const noexcept;
+
+    Element& z() noexcept;
+    const Element& z() const noexcept;
+
+    Element& w() noexcept;
+    const Element& w() const noexcept;
+
+  private:
+    alignas(detail::vector4_alignment<Element>) std::array<Element, 4> m_data;
+};
+
+using Quaternionf = Quaternion<float>;
+
+template <typename T>
+Quaternion<T> operator*(const Quaternion<T>& lhs, const Quaternion<T>& rhs) noexcept;
+
+template <typename T>
+bool operator==(const Quaternion<T>& lhs, const Quaternion<T>& rhs) noexcept;
+
+template <typename T>
+bool operator!=(const Quaternion<T>& lhs, const Quaternion<T>& rhs) noexcept;
+
+template <typename T>
+Quaternion<T> conjugate(const Quaternion<T>& q) noexcept;
+
+template <typename T>
+T dot_product(const Quaternion<T>& lhs, const Quaternion<T>& rhs) noexcept;
+
+template <typename T>
+Quaternion<T> normalize(const Quaternion<T>& q) noexcept;
+
+/**
+ *  Rotate v by the unit quaternion q.
+ */
+template <typename T>
+Vector3<T> rotate(const Quaternion<T>& q, const Vector3<T>& v) noexcept;
+
+/**
+ *  Rotation matrix of the unit quaternion q.
+ */
+template <typename T>
+Matrix3<T> to_matrix(const Quaternion<T>& q) noexcept;
+
+//
+// Quaternion implementation.
+//
+
+template <typename T>
+Quaternion<T>::Quaternion(T x, T y, T z, T w)
+  : m_data {x, y, z, w}
+{}
+
+template <typename T>
+Quaternion<T> Quaternion<T>::identity() noexcept
+{
+    return Quaternion(T(0), T(0), T(0), T(1));
+}
+
+template <typename T>
+Quaternion<T> Quaternion<T>::from_axis_angle(const Vector3<T>& axis, T angle) noexcept
+{
+    const auto s = std::sin(angle / T(2));
+    return Quaternion(axis[0] * s, axis[1] * s, axis[2] * s, std::cos(angle / T(2)));
+}
+
+template <typename T>
+T& Quaternion<T>::operator[](const std::size_t i) noexcept
+{
+    return m_data[i];
+}
+
+template <typename T>
+const T& Quaternion<T>::operator[](const std::size_t i) const noexcept
+{
+    return m_data[i];
+}
+
+template <typename T>
+T& Quaternion<T>::x() noexcept
+{
+    return m_data[0];
+}
+
+template <typename T>
+const T& Quaternion<T>::x() const noexcept
+{
+    return m_data[0];
+}
+
+template <typename T>
+T& Quaternion<T>::y() noexcept
+{
+    return m_data[1];
+}
+
+template <typename T>
+const T& Quaternion<T>::y() const noexcept
+{
+    return m_data[1];
+}
+
+template <typename T>
+T& Quaternion<T>::z() noexcept
+{
+    return m_data[2];
+}
+
+template <typename T>
+const T& Quaternion<T>::z() const noexcept
+{
+    return m_data[2];
+}
+
+template <typename T>
+T& Quaternion<T>::w() noexcept
+{
+    return m_data[3];
+}
+
+template <typename T>
+const T& Quaternion<T>::w() const noexcept
+{
+    return m_data[3];
+}
+
+template <typename T>
+Quaternion<T> operator*(const Quaternion<T>& lhs, const Quaternion<T>& rhs) noexcept
+{
+    return Quaternion<T>(
+        lhs.w() * rhs.x() + lhs.x() * rhs.w() + lhs.y() * rhs.z() - lhs.z() * rhs.y(),
+        lhs.w() * rhs.y() - lhs.x() * rhs.z() + lhs.y() * rhs.w() + lhs.z() * rhs.x(),
+        lhs.w() * rhs.z() + lhs.x() * rhs.y() - lhs.y() * rhs.x() + lhs.z() * rhs.w(),
+        lhs.w() * rhs.w() - lhs.x() * rhs.x() - lhs.y() * rhs.y() - lhs.z() * rhs.z());
+}
+
+template <typename T>
+bool operator==(const Quaternion<T>& lhs, const Quaternion<T>& rhs) noexcept
+{
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        if (lhs[i] != rhs[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T>
+bool operator!=(const Quaternion<T>& lhs, const Quaternion<T>& rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+
+template <typename T>
+Quaternion<T> conjugate(const Quaternion<T>& q) noexcept
+{
+    return Quaternion<T>(-q.x(), -q.y(), -q.z(), q.w());
+}
+
+template <typename T>
+T dot_product(const Quaternion<T>& lhs, const Quaternion<T>& rhs) noexcept
+{
+    T res = T(0);
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        res += lhs[i] * rhs[i];
+    }
+    return res;
+}
+
+template <typename T>
+Quaternion<T> normalize(const Quaternion<T>& q) noexcept
+{
+    const auto scale = T(1) / std::sqrt(dot_product(q, q));
+    return Quaternion<T>(q.x() * scale, q.y() * scale, q.z() * scale, q.w() * scale);
+}
+
+template <typename T>
+Vector3<T> rotate(const Quaternion<T>& q, const Vector3<T>& v) noexcept
+{
+    // v + w t + u x t, with t = 2 u x v.
+    const Vector3<T> u(q.x(), q.y(), q.z());
+    const auto t = cross_product(u, v) * T(2);
+
+    return v + t * q.w() + cross_product(u, t);
+}
+
+template <typename T>
+Matrix3<T> to_matrix(const Quaternion<T>& q) noexcept
+{
+    const auto x = q.x();
+    const auto y = q.y();
+    const auto z = q.z();
+    const auto w = q.w();
+
+    return Matrix3<T>({
+        T(1) - T(2) * (y * y + z * z),  T(2) * (x * y - z * w),         T(2) * (x * z + y * w),
+        T(2) * (x * y + z * w),         T(1) - T(2) * (x * x + z * z),  T(2) * (y * z - x * w),
+        T(2) * (x * z - y * w),         T(2) * (y * z + x * w),         T(1) - T(2) * (x * x + y * y)});
+}
+
+#ifdef MORPH_VECTOR_SSE
+
+//
+//  SSE implementation of Quaternionf.
+//
+//  Non-template overloads, preferred over the generic templates. The
+//  generic versions stay reachable with explicit template arguments,
+//  e.g. operator*<float>(a, b).
+//
+
+inline Quaternionf operator*(const Quaternionf& lhs, const Quaternionf& rhs) noexcept
+{
+    const auto a = detail::sse_load(lhs);
+    const auto b = detail::sse_load(rhs);
+
+    // lhs.w * (x, y, z, w) + lhs.x * (w, -z, y, -x)
+    //     + lhs.y * (z, w, -x, -y) + lhs.z * (-y, x, w, -z)
+    const auto b_wzyx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 1, 2, 3));
+    const auto b_zwxy = _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2));
+    const auto b_yxwz = _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 0, 1));
+
+    const auto sign_wzyx = _mm_setr_ps(0.0f, -0.0f, 0.0f, -0.0f);
+    const auto sign_zwxy = _mm_setr_ps(0.0f, 0.0f, -0.0f, -0.0f);
+    const auto sign_yxwz = _mm_setr_ps(-0.0f, 0.0f, 0.0f, -0.0f);
+
+    auto res = _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 3, 3)), b);
+    res = _mm_add_ps(res, _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 0, 0)), _mm_xor_ps(b_wzyx, sign_wzyx)));
+    res = _mm_add_ps(res, _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1)), _mm_xor_ps(b_zwxy, sign_zwxy)));
+    res = _mm_add_ps(res, _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 2, 2)), _mm_xor_ps(b_yxwz, sign_yxwz)));
+
+    return detail::sse_store<Quaternionf>(res);
+}
+
+inline float dot_product(const Quaternionf& lhs, const Quaternionf& rhs) noexcept
+{
+    return detail::sse_horizontal_sum(_mm_mul_ps(detail::sse_load(lhs), detail::sse_load(rhs)));
+}
+
+#endif // MORPH_VECTOR_SSE
+
+} // namespace foundation
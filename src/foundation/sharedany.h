@@ -1,12 +1,14 @@
 #pragma once
 
-#include <array>
+#include "foundation/typeid.h"
+
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <memory>
+#include <new>
 #include <string>
 #include <type_traits>
-#include <typeindex>
 #include <typeinfo>
 
 namespace foundation
@@ -14,9 +16,12 @@ namespace foundation
 namespace immutable
 {
 
-template<typename T> struct full_decay : std::decay<T> {};
-template<typename T> struct full_decay<T*> { using type = typename full_decay<T>::type*; };
-template<typename T> struct full_decay<T * const> { using type = typename full_decay<T>::type*; };
+// std::decay, also removing cv qualifiers of pointed types (arrays decay
+// to pointers first, so string literals are char pointers).
+template<typename T> struct full_decay_base { using type = T; };
+template<typename T> struct full_decay_base<T*> { using type = typename full_decay_base<std::remove_cv_t<T>>::type*; };
+
+template<typename T> struct full_decay : full_decay_base<std::decay_t<T>> {};
 template<typename T> using full_decay_t = typename full_decay<T>::type;
 
 
@@ -44,30 +49,6 @@ template<typename T> struct is_str : is_str_base<full_decay_t<T>> {};
 template<typename T> inline constexpr bool is_str_v = is_str<T>::value;
 
 
-template <typename T>
-std::size_t get_hash() noexcept
-{
-    return typeid(T).hash_code();
-}
-
-std::array<std::size_t, 8> int_types
-{
-    get_hash<int8_t>(),
-    get_hash<uint8_t>(),
-    get_hash<int16_t>(),
-    get_hash<uint16_t>(),
-    get_hash<int32_t>(),
-    get_hash<uint32_t>(),
-    get_hash<int64_t>(),
-    get_hash<uint64_t>()
-};
-
-std::array<std::size_t, 2> str_types
-{
-    get_hash<char*>(),
-    get_hash<std::string>()
-};
-
 enum class Type
 {
     str_types,
@@ -75,43 +56,109 @@ enum class Type
     random_types
 };
 
+/**
+ *  Type erased immutable value.
+ *
+ *  Values of small trivially copyable types (scalars, small PODs) are
+ *  stored inline, other values are shared between copies on the heap.
+ *  Strings, either std::string or char pointers, are stored as std::string.
+ *  Integers also keep a copy widened to 64 bits next to the value, which
+ *  converts to any other integer type without dispatching on the stored one.
+ */
 class SharedAny
 {
   public:
+    static constexpr std::size_t inline_size = sizeof(std::shared_ptr<void>);
+
+    template <typename T>
+    static constexpr bool is_stored_inline =
+        std::is_trivially_copyable_v<T>
+        && sizeof(T) <= inline_size
+        && alignof(T) <= alignof(std::shared_ptr<void>);
+
     template <typename T,
               std::enable_if_t<is_int_v<full_decay_t<T>>, int> = 0>
     SharedAny(T&& value)
-      : m_data(new full_decay_t<T>(std::forward<T>(value)))
-      , m_hash_type(get_hash<T>())
+      : m_type_id(type_id<T>)
       , m_type(Type::int_types)
     {
-        m_num = static_cast<int>(int_types.size()) - 1;
-        for (; m_num != -1; --m_num)
-        {
-            if (m_hash_type == int_types[m_num])
-            {
-                break;
-            }
-        }
+        const auto wide = static_cast<std::uint64_t>(value);
+
+        emplace<full_decay_t<T>>(std::forward<T>(value));
+        std::memcpy(m_storage.m_inline + wide_int_offset, &wide, sizeof(wide));
     }
 
     template <typename T,
               std::enable_if_t<is_str_v<full_decay_t<T>>, int> = 0>
     SharedAny(T&& value)
-      : m_data(new std::string(std::forward<T>(value)))
-      , m_hash_type(get_hash<T>())
+      : m_type_id(type_id<std::string>)
       , m_type(Type::str_types)
-    {}
+    {
+        emplace<std::string>(std::forward<T>(value));
+    }
 
     template <typename T,
               std::enable_if_t<!is_str_v<full_decay_t<T>>, int> = 0,
-              std::enable_if_t<!is_int_v<full_decay_t<T>>, int> = 0>
+              std::enable_if_t<!is_int_v<full_decay_t<T>>, int> = 0,
+              std::enable_if_t<!std::is_same_v<full_decay_t<T>, SharedAny>, int> = 0>
     SharedAny(T&& value)
-      : m_data(new full_decay_t<T>(std::forward<T>(value)))
-      , m_hash_type(get_hash<T>())
+      : m_type_id(unique_type_id<T>())
       , m_type(Type::random_types)
-    {}
+    {
+        emplace<full_decay_t<T>>(std::forward<T>(value));
+    }
 
+    SharedAny(const SharedAny& other) noexcept
+    {
+        copy_from(other);
+    }
+
+    SharedAny(SharedAny&& other) noexcept
+    {
+        move_from(std::move(other));
+    }
+
+    SharedAny& operator=(const SharedAny& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            copy_from(other);
+        }
+
+        return *this;
+    }
+
+    SharedAny& operator=(SharedAny&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            move_from(std::move(other));
+        }
+
+        return *this;
+    }
+
+    ~SharedAny()
+    {
+        reset();
+    }
+
+    /**
+     *  Pointer to the value if it is a T, nullptr otherwise.
+     *  Never allocates, unlike pure_cast() and cast().
+     */
+    template <typename T>
+    const T* get() const noexcept
+    {
+        return pure_is<T>() ? static_cast<const T*>(data()) : nullptr;
+    }
+
+    /**
+     *  Shared pointer to the value, or to a copy of it if the value
+     *  is stored inline.
+     */
     template <typename T>
     std::shared_ptr<T> pure_cast() const
     {
@@ -119,90 +166,104 @@ class SharedAny
         {
             throw std::bad_cast();
         }
+        else if (m_is_inline)
+        {
+            return std::make_shared<T>(*static_cast<const T*>(data()));
+        }
         else
         {
-            return std::reinterpret_pointer_cast<T>(m_data);
+            return std::reinterpret_pointer_cast<T>(m_storage.m_shared);
         }
     }
 
+    /**
+     *  Types in anonymous namespaces of different translation units
+     *  may share their type_id, so they are told apart by unique_type_id().
+     */
     template <typename T>
     bool pure_is() const noexcept
     {
-        return get_hash<T>() == m_hash_type;
+        return unique_type_id<T>() == m_type_id;
     }
 
+    /**
+     *  The value converted to T: any integer type converts to any other,
+     *  strings convert to std::string and char pointers (pointing into
+     *  the stored string), other types must match exactly.
+     *  Only allocates to copy strings.
+     */
     template <typename T,
               std::enable_if_t<is_int_v<full_decay_t<T>>, int> = 0>
-    std::shared_ptr<T> cast() const
+    T value() const
     {
         if (!is<T>())
         {
             throw std::bad_cast();
         }
-        else
-        {
-            T val;
-
-            switch (m_num)
-            {
-                case 0: val = (static_cast<T>(*(std::reinterpret_pointer_cast<int8_t>(m_data)))); break;
-                case 1: val = (static_cast<T>(*(std::reinterpret_pointer_cast<uint8_t>(m_data)))); break;
-                case 2: val = (static_cast<T>(*(std::reinterpret_pointer_cast<int16_t>(m_data)))); break;
-                case 3: val = (static_cast<T>(*(std::reinterpret_pointer_cast<uint16_t>(m_data)))); break;
-                case 4: val = (static_cast<T>(*(std::reinterpret_pointer_cast<int32_t>(m_data)))); break;
-                case 5: val = (static_cast<T>(*(std::reinterpret_pointer_cast<uint32_t>(m_data)))); break;
-                case 6: val = (static_cast<T>(*(std::reinterpret_pointer_cast<int64_t>(m_data)))); break;
-                case 7: val = (static_cast<T>(*(std::reinterpret_pointer_cast<uint64_t>(m_data)))); break;
-            }
-
-            return std::make_shared<T>(val);
-        }
+
+        // Narrowing from the widened copy truncates just like
+        // converting the stored value directly.
+        std::uint64_t wide;
+        std::memcpy(&wide, m_storage.m_inline + wide_int_offset, sizeof(wide));
+
+        return static_cast<T>(wide);
     }
 
     template <typename T,
               std::enable_if_t<std::is_same_v<full_decay_t<T>, std::string>, int> = 0>
-    std::shared_ptr<T> cast() const
+    T value() const
     {
         if (!is<T>())
         {
             throw std::bad_cast();
         }
-        else
-        {
-            std::string str = *std::reinterpret_pointer_cast<std::string>(m_data);
-            return std::make_shared<T>(str);
-        }
+
+        return *static_cast<const std::string*>(data());
     }
 
     template <typename T,
               std::enable_if_t<is_str_v<full_decay_t<T>>, int> = 0,
               std::enable_if_t<!std::is_same_v<full_decay_t<T>, std::string>, int> = 0>
-    std::shared_ptr<T> cast() const
+    T value() const
     {
         if (!is<T>())
         {
             throw std::bad_cast();
         }
-        else
-        {
-            std::string str = *std::reinterpret_pointer_cast<std::string>(m_data);
-            return std::make_shared<T>(str.data());
-        }
+
+        return const_cast<char*>(static_cast<const std::string*>(data())->data());
     }
 
     template <typename T,
               std::enable_if_t<!is_str_v<full_decay_t<T>>, int> = 0,
               std::enable_if_t<!is_int_v<full_decay_t<T>>, int> = 0>
-    std::shared_ptr<T> cast() const
+    T value() const
     {
         if (!is<T>())
         {
             throw std::bad_cast();
         }
-        else
-        {
-            return std::reinterpret_pointer_cast<T>(m_data);
-        }
+
+        return *static_cast<const T*>(data());
+    }
+
+    /**
+     *  Shared pointer to value<T>(), except for types other than integers
+     *  and strings, which behave as with pure_cast().
+     */
+    template <typename T,
+              std::enable_if_t<is_int_v<full_decay_t<T>> || is_str_v<full_decay_t<T>>, int> = 0>
+    std::shared_ptr<T> cast() const
+    {
+        return std::make_shared<T>(value<T>());
+    }
+
+    template <typename T,
+              std::enable_if_t<!is_str_v<full_decay_t<T>>, int> = 0,
+              std::enable_if_t<!is_int_v<full_decay_t<T>>, int> = 0>
+    std::shared_ptr<T> cast() const
+    {
+        return pure_cast<T>();
     }
 
     template <typename T,
@@ -228,10 +289,84 @@ class SharedAny
     }
 
   private:
-    std::shared_ptr<void>  m_data;
-    const std::size_t      m_hash_type;
-    int                    m_num;
-    Type                   m_type;
+    static constexpr std::size_t wide_int_offset = sizeof(std::uint64_t);
+
+    static_assert(is_stored_inline<std::int64_t> && is_stored_inline<std::uint64_t>
+                  && wide_int_offset + sizeof(std::uint64_t) <= inline_size,
+                  "Integers and their widened copy must fit inline.");
+
+    union Storage
+    {
+        Storage() noexcept {}
+        ~Storage() {}
+
+        std::shared_ptr<void>                                   m_shared;
+        alignas(std::shared_ptr<void>) unsigned char            m_inline[inline_size];
+    };
+
+    template <typename U, typename... Args>
+    void emplace(Args&&... args)
+    {
+        if constexpr (is_stored_inline<U>)
+        {
+            new (m_storage.m_inline) U(std::forward<Args>(args)...);
+            m_is_inline = true;
+        }
+        else
+        {
+            new (&m_storage.m_shared) std::shared_ptr<void>(std::make_shared<U>(std::forward<Args>(args)...));
+            m_is_inline = false;
+        }
+    }
+
+    const void* data() const noexcept
+    {
+        return m_is_inline ? static_cast<const void*>(m_storage.m_inline) : m_storage.m_shared.get();
+    }
+
+    void copy_from(const SharedAny& other) noexcept
+    {
+        if (other.m_is_inline)
+        {
+            std::memcpy(m_storage.m_inline, other.m_storage.m_inline, inline_size);
+        }
+        else
+        {
+            new (&m_storage.m_shared) std::shared_ptr<void>(other.m_storage.m_shared);
+        }
+
+        m_type_id = other.m_type_id;
+        m_type = other.m_type;
+        m_is_inline = other.m_is_inline;
+    }
+
+    void move_from(SharedAny&& other) noexcept
+    {
+        if (other.m_is_inline)
+        {
+            copy_from(other);
+            return;
+        }
+
+        new (&m_storage.m_shared) std::shared_ptr<void>(std::move(other.m_storage.m_shared));
+
+        m_type_id = other.m_type_id;
+        m_type = other.m_type;
+        m_is_inline = false;
+    }
+
+    void reset() noexcept
+    {
+        if (!m_is_inline)
+        {
+            m_storage.m_shared.~shared_ptr();
+        }
+    }
+
+    Storage         m_storage;
+    TypeId          m_type_id;
+    Type            m_type;
+    bool            m_is_inline;
 };
 
 } // namespace immutable
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+namespace foundation
+{
+
+/**
+ *  Bounded lock-free queue with a single producer and a single consumer.
+ *
+ *  Head and tail live on separate cache lines and each side keeps
+ *  a cached copy of the other side's index, so a push or a pop only touches
+ *  the shared indices when the cached one says the queue is full (empty).
+ */
+template <typename T>
+class SpscQueue
+{
+  public:
+    static_assert(
+        std::is_trivially_copyable_v<T>,
+        "Elements are copied in and out of the ring buffer.");
+
+    /**
+     *  Capacity is rounded up to a power of two.
+     */
+    explicit SpscQueue(std::size_t capacity)
+      : m_mask(round_up_to_power_of_two(capacity) - 1u)
+      , m_data(new T[m_mask + 1u])
+    {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    std::size_t capacity() const noexcept
+    {
+        return m_mask + 1u;
+    }
+
+    /**
+     *  Producer side. Returns false if the queue is full.
+     */
+    bool try_push(const T& value) noexcept
+    {
+        const auto tail = m_tail.load(std::memory_order_relaxed);
+
+        if (tail - m_producer.m_cached_head > m_mask)
+        {
+            m_producer.m_cached_head = m_head.load(std::memory_order_acquire);
+
+            if (tail - m_producer.m_cached_head > m_mask)
+            {
+                return false;
+            }
+        }
+
+        m_data[tail & m_mask] = value;
+        m_tail.store(tail + 1u, std::memory_order_release);
+
+        return true;
+    }
+
+    /**
+     *  Consumer side. Returns false if the queue is empty.
+     */
+    bool try_pop(T& value) noexcept
+    {
+        const auto head = m_head.load(std::memory_order_relaxed);
+
+        if (head == m_consumer.m_cached_tail)
+        {
+            m_consumer.m_cached_tail = m_tail.load(std::memory_order_acquire);
+
+            if (head == m_consumer.m_cached_tail)
+            {
+                return false;
+            }
+        }
+
+        value = m_data[head & m_mask];
+        m_head.store(head + 1u, std::memory_order_release);
+
+        return true;
+    }
+
+    /**
+     *  Only exact when called from either side while the other one is idle.
+     */
+    bool empty() const noexcept
+    {
+        return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+    }
+
+  private:
+    static constexpr std::size_t cache_line_size = 64u;
+
+    static std::size_t round_up_to_power_of_two(std::size_t n) noexcept
+    {
+        std::size_t result = 1u;
+        while (result < n)
+        {
+            result <<= 1u;
+        }
+
+        return result;
+    }
+
+    struct alignas(cache_line_size) ProducerState
+    {
+        std::size_t m_cached_head = 0u;
+    };
+
+    struct alignas(cache_line_size) ConsumerState
+    {
+        std::size_t m_cached_tail = 0u;
+    };
+
+    const std::size_t           m_mask;
+    const std::unique_ptr<T[]>  m_data;
+
+    alignas(cache_line_size) std::atomic<std::size_t> m_tail {0u};
+    ProducerState                                     m_producer;
+
+    alignas(cache_line_size) std::atomic<std::size_t> m_head {0u};
+    ConsumerState                                     m_consumer;
+};
+
+} // namespace foundation
@@ -0,0 +1,184 @@
+#pragma once
+
+#include "foundation/immutable/detail/appendbuffer.h"
+#include "foundation/immutable/detail/memorypolicy.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace foundation
+{
+
+/**
+ *  Immutable list of subscribers sorted by key.
+ *
+ *  Up to InlineSize subscribers are stored inline, larger lists share
+ *  a heap allocated buffer between copies. Either way the subscribers
+ *  are contiguous, so iterating them is a plain loop over an array.
+ *
+ *  Keys are expected to grow with every subscription, so the list keeps
+ *  the subscription order and insert() is usually an append, which reuses
+ *  the free space of the shared buffer, unless another version has already
+ *  used it. Callbacks are shared as well: building a new buffer only copies
+ *  keys and pointers.
+ */
+template <typename Key, typename Fn, std::size_t InlineSize = 4>
+class SubscriberList
+{
+  public:
+    using value_type     = std::pair<Key, std::shared_ptr<const Fn>>;
+    using const_iterator = const value_type*;
+
+    SubscriberList() = default;
+
+    /**
+     *  Return a list with fn added under key, which must not be
+     *  in the list yet.
+     */
+    SubscriberList insert(Key key, Fn fn) const
+    {
+        value_type entry(key, std::make_shared<const Fn>(std::move(fn)));
+
+        const auto it = lower_bound(key);
+
+        if (it == end() && m_heap && m_heap->try_append(m_size, entry))
+        {
+            return SubscriberList(m_heap, m_size + 1u);
+        }
+
+        SubscriberList result;
+        result.m_size = m_size + 1u;
+
+        if (result.m_size <= InlineSize)
+        {
+            auto out = std::copy(begin(), it, result.m_inline.begin());
+            *out = std::move(entry);
+            std::copy(it, end(), out + 1);
+        }
+        else
+        {
+            auto heap = make_heap(result.m_size);
+            auto size = append(*heap, 0u, begin(), it);
+            heap->try_append(size++, entry);
+            append(*heap, size, it, end());
+
+            result.m_heap = std::move(heap);
+        }
+
+        return result;
+    }
+
+    /**
+     *  Return a list without the subscriber under key, if any.
+     */
+    SubscriberList erase(Key key) const
+    {
+        const auto it = find(key);
+
+        if (it == end())
+        {
+            return *this;
+        }
+
+        SubscriberList result;
+        result.m_size = m_size - 1u;
+
+        if (result.m_size <= InlineSize)
+        {
+            auto out = std::copy(begin(), it, result.m_inline.begin());
+            std::copy(it + 1, end(), out);
+        }
+        else
+        {
+            // Sharing the buffer would keep the erased callback alive.
+            auto heap = make_heap(result.m_size);
+            const auto size = append(*heap, 0u, begin(), it);
+            append(*heap, size, it + 1, end());
+
+            result.m_heap = std::move(heap);
+        }
+
+        return result;
+    }
+
+    const_iterator find(Key key) const noexcept
+    {
+        const auto it = lower_bound(key);
+        return (it != end() && it->first == key) ? it : end();
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return m_heap ? &(*m_heap)[0] : m_inline.data();
+    }
+
+    const_iterator end() const noexcept
+    {
+        return begin() + m_size;
+    }
+
+    std::size_t size() const noexcept
+    {
+        return m_size;
+    }
+
+    bool empty() const noexcept
+    {
+        return m_size == 0u;
+    }
+
+  private:
+    using Buffer    = immutable::detail::AppendBuffer<value_type, immutable::detail::HeapMemoryPolicy>;
+    using BufferPtr = std::shared_ptr<Buffer>;
+
+    SubscriberList(BufferPtr heap, std::size_t size) noexcept
+      : m_size(size)
+      , m_heap(std::move(heap))
+    {}
+
+    // Leave room to append as many subscribers as the list already has.
+    static BufferPtr make_heap(std::size_t size)
+    {
+        return std::make_shared<Buffer>(2u * size);
+    }
+
+    // Copy [first, last) into a buffer of the given size that is not
+    // shared yet, so appending can't fail. Return the new size.
+    static std::size_t append(Buffer& heap, std::size_t size, const_iterator first, const_iterator last)
+    {
+        for (; first != last; ++first, ++size)
+        {
+            value_type entry(*first);
+            heap.try_append(size, entry);
+        }
+
+        return size;
+    }
+
+    const_iterator lower_bound(Key key) const noexcept
+    {
+        // Subscribers are mostly appended, check the back first.
+        if (m_size == 0u || (end() - 1)->first < key)
+        {
+            return end();
+        }
+
+        return std::lower_bound(
+            begin(),
+            end(),
+            key,
+            [](const value_type& entry, const Key& key)
+            {
+                return entry.first < key;
+            });
+    }
+
+    std::size_t                                 m_size = 0u;
+    std::array<value_type, InlineSize>          m_inline;
+    BufferPtr                                   m_heap;
+};
+
+} // namespace foundation
@@ -0,0 +1,219 @@
+#include "taskgraph.h"
+
+#include <tbb/task_group.h>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace foundation
+{
+
+struct TaskGraph::Impl
+{
+    struct Node
+    {
+        Task                    m_task;
+        std::vector<NodeId>     m_successors;
+        bool                    m_is_dirty;
+    };
+
+    using PendingCounters = std::unique_ptr<std::atomic<std::size_t>[]>;
+
+    void check_node_id(NodeId node) const;
+    void run_node(NodeId node);
+
+    std::vector<Node>   m_nodes;
+
+    // Execution state, valid only while execute() is running.
+    PendingCounters             m_pending;
+    std::atomic<std::size_t>    m_executed_count;
+    tbb::task_group*            m_task_group;
+};
+
+void TaskGraph::Impl::check_node_id(NodeId node) const
+{
+    if (node >= m_nodes.size())
+    {
+        throw std::out_of_range("Invalid task graph node id.");
+    }
+}
+
+void TaskGraph::Impl::run_node(NodeId node)
+{
+    while (true)
+    {
+        auto& n = m_nodes[node];
+
+        if (n.m_task)
+        {
+            n.m_task();
+        }
+
+        n.m_is_dirty = false;
+        m_executed_count.fetch_add(1, std::memory_order_relaxed);
+
+        // Continue with the first successor that became ready
+        // on this thread, spawn the rest.
+        bool has_next = false;
+        NodeId next = 0u;
+
+        for (auto successor : n.m_successors)
+        {
+            if (m_pending[successor].fetch_sub(1, std::memory_order_acq_rel) != 1u)
+            {
+                continue;
+            }
+
+            if (!has_next)
+            {
+                has_next = true;
+                next = successor;
+            }
+            else
+            {
+                m_task_group->run([this, successor]() { run_node(successor); });
+            }
+        }
+
+        if (!has_next)
+        {
+            return;
+        }
+
+        node = next;
+    }
+}
+
+TaskGraph::TaskGraph()
+  : m_impl(new Impl())
+{}
+
+TaskGraph::~TaskGraph()
+{
+    delete m_impl;
+}
+
+TaskGraph::NodeId TaskGraph::add_node(Task task)
+{
+    m_impl->m_nodes.push_back(Impl::Node {std::move(task), {}, true});
+    return m_impl->m_nodes.size() - 1;
+}
+
+void TaskGraph::add_dependency(NodeId node, NodeId dependency)
+{
+    m_impl->check_node_id(node);
+    m_impl->check_node_id(dependency);
+
+    m_impl->m_nodes[dependency].m_successors.push_back(node);
+    mark_dirty(node);
+}
+
+void TaskGraph::mark_dirty(NodeId node)
+{
+    m_impl->check_node_id(node);
+
+    // Successors of a dirty node are always dirty,
+    // so the traversal stops at already dirty nodes.
+    std::vector<NodeId> stack;
+
+    m_impl->m_nodes[node].m_is_dirty = true;
+    stack.push_back(node);
+
+    while (!stack.empty())
+    {
+        auto current = stack.back();
+        stack.pop_back();
+
+        for (auto successor : m_impl->m_nodes[current].m_successors)
+        {
+            auto& n = m_impl->m_nodes[successor];
+
+            if (!n.m_is_dirty)
+            {
+                n.m_is_dirty = true;
+                stack.push_back(successor);
+            }
+        }
+    }
+}
+
+bool TaskGraph::is_dirty(NodeId node) const
+{
+    m_impl->check_node_id(node);
+    return m_impl->m_nodes[node].m_is_dirty;
+}
+
+std::size_t TaskGraph::size() const noexcept
+{
+    return m_impl->m_nodes.size();
+}
+
+void TaskGraph::execute()
+{
+    auto& nodes = m_impl->m_nodes;
+    const auto nodes_count = nodes.size();
+
+    m_impl->m_pending.reset(new std::atomic<std::size_t>[nodes_count]);
+    for (std::size_t i = 0; i < nodes_count; ++i)
+    {
+        m_impl->m_pending[i].store(0u, std::memory_order_relaxed);
+    }
+
+    std::size_t dirty_count = 0u;
+    for (const auto& n : nodes)
+    {
+        if (!n.m_is_dirty)
+        {
+            continue;
+        }
+
+        ++dirty_count;
+        for (auto successor : n.m_successors)
+        {
+            m_impl->m_pending[successor].fetch_add(1u, std::memory_order_relaxed);
+        }
+    }
+
+    if (dirty_count == 0u)
+    {
+        return;
+    }
+
+    tbb::task_group task_group;
+
+    m_impl->m_executed_count.store(0u, std::memory_order_relaxed);
+    m_impl->m_task_group = &task_group;
+
+    for (NodeId i = 0; i < nodes_count; ++i)
+    {
+        if (nodes[i].m_is_dirty && m_impl->m_pending[i].load(std::memory_order_relaxed) == 0u)
+        {
+            task_group.run([this, i]() { m_impl->run_node(i); });
+        }
+    }
+
+    try
+    {
+        task_group.wait();
+    }
+    catch (...)
+    {
+        m_impl->m_task_group = nullptr;
+        m_impl->m_pending.reset();
+        throw;
+    }
+
+    m_impl->m_task_group = nullptr;
+    m_impl->m_pending.reset();
+
+    if (m_impl->m_executed_count.load() != dirty_count)
+    {
+        throw std::logic_error("Task graph contains a cycle.");
+    }
+}
+
+} // namespace foundation
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace foundation
+{
+
+/**
+ *  Dependency graph of tasks executed in parallel on TBB worker threads.
+ *
+ *  A node is executed only after all of its dependencies have finished,
+ *  independent branches run concurrently. Nodes are dirty when added;
+ *  execute() runs dirty nodes only and marks them clean, so after an edit
+ *  only the edited node and its downstream nodes need to be re-executed.
+ *
+ *  The graph itself is not thread safe: it must not be modified while
+ *  execute() is running.
+ */
+class TaskGraph
+{
+  public:
+    using Task   = std::function<void()>;
+    using NodeId = std::size_t;
+
+    TaskGraph();
+    ~TaskGraph();
+
+    TaskGraph(const TaskGraph&) = delete;
+    TaskGraph& operator=(const TaskGraph&) = delete;
+
+    NodeId add_node(Task task);
+
+    /**
+     *  Make node execute after dependency.
+     *  Marks node (and everything downstream of it) dirty.
+     */
+    void add_dependency(NodeId node, NodeId dependency);
+
+    /**
+     *  Mark node and everything downstream of it for re-execution.
+     */
+    void mark_dirty(NodeId node);
+
+    bool is_dirty(NodeId node) const;
+
+    std::size_t size() const noexcept;
+
+    /**
+     *  Execute dirty nodes and block until they are done.
+     *  If a task throws, the nodes that didn't get to run stay dirty
+     *  and the exception is rethrown. Throws std::logic_error if the
+     *  dirty part of the graph contains a cycle.
+     */
+    void execute();
+
+  private:
+    struct Impl;
+    Impl* m_impl;
+};
+
+} // namespace foundation
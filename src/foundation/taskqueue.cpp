@@ -4,7 +4,15 @@
 #include <tbb/spin_mutex.h>
 #include <tbb/task.h>
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
 #include <utility>
 
 namespace foundation
@@ -12,75 +20,249 @@ namespace foundation
 namespace
 {
 
+using Clock = std::chrono::steady_clock;
+
+struct TaskTiming
+{
+    // Left default constructed when statistics are disabled.
+    Clock::time_point   m_posted_at;
+    Clock::time_point   m_started_at;
+    Clock::time_point   m_finished_at;
+};
+
 class TaskWrapper : public tbb::task
 {
   public:
-    using OnTaskFinished = std::function<void()>;
+    using OnTaskFinished = std::function<void(const TaskTiming&)>;
 
-    TaskWrapper(TaskQueue::Task&& t, OnTaskFinished&& cb)
+    TaskWrapper(TaskQueue::Task&& t, Clock::time_point posted_at, OnTaskFinished&& cb)
       : m_t(std::move(t))
       , m_cb(std::move(cb))
-    {}
+    {
+        m_timing.m_posted_at = posted_at;
+    }
 
     virtual tbb::task* execute() override;
 
   private:
     TaskQueue::Task     m_t;
     OnTaskFinished      m_cb;
+    TaskTiming          m_timing;
 };
 
 tbb::task* TaskWrapper::execute()
 {
+    const bool is_timed = m_timing.m_posted_at != Clock::time_point();
+
+    if (is_timed)
+    {
+        m_timing.m_started_at = Clock::now();
+    }
+
     if (m_t)
     {
         m_t();
     }
 
+    if (is_timed)
+    {
+        m_timing.m_finished_at = Clock::now();
+    }
+
     if (m_cb)
     {
-        m_cb();
+        m_cb(m_timing);
     }
 
     return nullptr;
 }
 
+std::uint64_t to_nanoseconds(Clock::duration d)
+{
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(d).count());
+}
+
+/**
+ *  Thread posting delayed tasks to their queues once they are due.
+ */
+class Timer
+{
+  public:
+    /**
+     *  Never destroyed, so that queues destroyed during static
+     *  destruction can still cancel their tasks. The thread is left
+     *  blocked on the condition variable when the process exits.
+     */
+    static Timer& instance()
+    {
+        static Timer* timer = new Timer();
+        return *timer;
+    }
+
+    void schedule(TaskQueue& queue, Clock::time_point deadline, TaskQueue::Task&& task)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (!m_thread.joinable())
+        {
+            m_thread = std::thread([this]() { run(); });
+        }
+
+        m_entries.emplace(deadline, Entry {&queue, std::move(task)});
+        m_cv.notify_one();
+    }
+
+    /**
+     *  Drop the tasks scheduled for the queue. Once this returns
+     *  the timer doesn't access the queue anymore.
+     */
+    void cancel(const TaskQueue& queue)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        for (auto it = m_entries.begin(); it != m_entries.end();)
+        {
+            if (it->second.m_queue == &queue)
+            {
+                it = m_entries.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+  private:
+    struct Entry
+    {
+        TaskQueue*      m_queue;
+        TaskQueue::Task m_task;
+    };
+
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        for (;;)
+        {
+            if (m_entries.empty())
+            {
+                m_cv.wait(lock);
+                continue;
+            }
+
+            const auto it = m_entries.begin();
+
+            if (it->first > Clock::now())
+            {
+                m_cv.wait_until(lock, it->first);
+                continue;
+            }
+
+            // Posted under the lock, so that cancel() can't return
+            // while the queue is being accessed.
+            it->second.m_queue->post(std::move(it->second.m_task));
+            m_entries.erase(it);
+        }
+    }
+
+    // Ordered by deadline, in scheduling order for equal deadlines.
+    std::multimap<Clock::time_point, Entry> m_entries;
+    std::mutex                              m_mutex;
+    std::condition_variable                 m_cv;
+    std::thread                             m_thread;
+};
+
 } // namespace
 
 struct TaskQueue::Impl
 {
+    using Lock = std::unique_lock<tbb::spin_mutex>;
+
+    struct QueuedTask
+    {
+        Task                m_task;
+        Clock::time_point   m_posted_at;
+    };
+
     Impl(tbb::priority_t priority)
       : m_is_busy(false)
+      , m_is_closed(false)
+      , m_posted_count(0u)
+      , m_retired_count(0u)
+      , m_waiters_count(0u)
       , m_priority(priority)
-    {}
+      , m_has_delayed_tasks(false)
+      , m_collect_statistics(false)
+    {
+        reset_statistics();
+    }
+
+    void enqueue_task(QueuedTask&& task);
+    void on_task_finished(const TaskTiming& timing);
+
+    // Must be called with m_mutex held.
+    std::size_t depth() const noexcept;
+    void reset_statistics();
+
+    // Drop the tasks that are still waiting in the queue.
+    // Must be called with m_mutex held.
+    void discard_pending_tasks();
 
-    void enqueue_task(Task&& task);
-    void on_task_finished();
+    template <typename Predicate>
+    void wait(Lock& lock, Predicate predicate);
 
-    tbb::concurrent_queue<Task>     m_queue;
-    tbb::task_group_context         m_ctx;
-    tbb::spin_mutex                 m_mutex;
-    bool                            m_is_busy;
-    tbb::priority_t                 m_priority;
+    template <typename Predicate>
+    bool wait_until(
+        Lock&                                   lock,
+        std::chrono::steady_clock::time_point   deadline,
+        Predicate                               predicate);
+
+    tbb::concurrent_queue<QueuedTask>   m_queue;
+    tbb::task_group_context             m_ctx;
+    mutable tbb::spin_mutex             m_mutex;
+    std::condition_variable_any         m_idle_cv;
+    bool                                m_is_busy;
+    bool                                m_is_closed;
+    std::uint64_t                       m_posted_count;
+    std::uint64_t                       m_retired_count;
+    std::size_t                         m_waiters_count;
+    tbb::priority_t                     m_priority;
+    std::atomic<bool>                   m_has_delayed_tasks;
+
+    // Statistics, guarded by m_mutex.
+    bool                                m_collect_statistics;
+    Clock::time_point                   m_statistics_started_at;
+    Statistics                          m_statistics;
 };
 
-void TaskQueue::Impl::enqueue_task(Task&& task)
+void TaskQueue::Impl::enqueue_task(QueuedTask&& task)
 {
     TaskWrapper* w = new (tbb::task::allocate_root(m_ctx))
-            TaskWrapper(std::move(task), [=]() { return on_task_finished(); });
+            TaskWrapper(
+                std::move(task.m_task),
+                task.m_posted_at,
+                [=](const TaskTiming& timing) { return on_task_finished(timing); });
 
     tbb::task::enqueue(*w, m_priority);
 }
 
-void TaskQueue::Impl::on_task_finished()
+void TaskQueue::Impl::on_task_finished(const TaskTiming& timing)
 {
     tbb::spin_mutex::scoped_lock lock(m_mutex);
 
-    if (m_ctx.is_group_execution_cancelled())
+    ++m_retired_count;
+
+    if (m_collect_statistics && timing.m_posted_at >= m_statistics_started_at)
     {
-        return;
+        m_statistics.wait_time.record(to_nanoseconds(timing.m_started_at - timing.m_posted_at));
+        m_statistics.execution_time.record(to_nanoseconds(timing.m_finished_at - timing.m_started_at));
+        ++m_statistics.executed_count;
     }
 
-    Task task;
+    QueuedTask task;
     if (m_queue.try_pop(task))
     {
         enqueue_task(std::move(task));
@@ -89,6 +271,59 @@ void TaskQueue::Impl::on_task_finished()
     {
         m_is_busy = false;
     }
+
+    // Notify while still holding the lock: once a waiter observes
+    // the queue as idle it may destroy it.
+    if (m_waiters_count != 0u)
+    {
+        m_idle_cv.notify_all();
+    }
+}
+
+std::size_t TaskQueue::Impl::depth() const noexcept
+{
+    return static_cast<std::size_t>(m_posted_count - m_retired_count);
+}
+
+void TaskQueue::Impl::reset_statistics()
+{
+    m_statistics.wait_time.reset();
+    m_statistics.execution_time.reset();
+    m_statistics.depth = 0u;
+    m_statistics.max_depth = depth();
+    m_statistics.executed_count = 0u;
+    m_statistics.tasks_per_second = 0.0;
+    m_statistics_started_at = Clock::now();
+}
+
+void TaskQueue::Impl::discard_pending_tasks()
+{
+    QueuedTask task;
+    while (m_queue.try_pop(task))
+    {
+        ++m_retired_count;
+    }
+}
+
+template <typename Predicate>
+void TaskQueue::Impl::wait(Lock& lock, Predicate predicate)
+{
+    ++m_waiters_count;
+    m_idle_cv.wait(lock, predicate);
+    --m_waiters_count;
+}
+
+template <typename Predicate>
+bool TaskQueue::Impl::wait_until(
+    Lock&                                   lock,
+    std::chrono::steady_clock::time_point   deadline,
+    Predicate                               predicate)
+{
+    ++m_waiters_count;
+    bool res = m_idle_cv.wait_until(lock, deadline, predicate);
+    --m_waiters_count;
+
+    return res;
 }
 
 TaskQueue::TaskQueue(Priority priority)
@@ -118,23 +353,159 @@ TaskQueue::TaskQueue(Priority priority)
 
 TaskQueue::~TaskQueue()
 {
-    m_impl->m_ctx.cancel_group_execution();
+    if (m_impl->m_has_delayed_tasks.load(std::memory_order_acquire))
+    {
+        Timer::instance().cancel(*this);
+    }
+
+    {
+        Impl::Lock lock(m_impl->m_mutex);
+
+        m_impl->m_is_closed = true;
+        m_impl->discard_pending_tasks();
+
+        // The task in flight references m_impl through its completion
+        // callback, so it must finish before m_impl can be released.
+        m_impl->wait(lock, [this]() { return !m_impl->m_is_busy; });
+    }
+
     delete m_impl;
 }
 
-void TaskQueue::post(Task task)
+bool TaskQueue::post(Task task)
 {
     tbb::spin_mutex::scoped_lock lock(m_impl->m_mutex);
 
+    if (m_impl->m_is_closed)
+    {
+        return false;
+    }
+
+    ++m_impl->m_posted_count;
+
+    Impl::QueuedTask queued_task {std::move(task), Clock::time_point()};
+
+    if (m_impl->m_collect_statistics)
+    {
+        queued_task.m_posted_at = Clock::now();
+
+        const auto depth = m_impl->depth();
+        if (depth > m_impl->m_statistics.max_depth)
+        {
+            m_impl->m_statistics.max_depth = depth;
+        }
+    }
+
     if (!m_impl->m_is_busy)
     {
-        m_impl->enqueue_task(std::move(task));
+        m_impl->enqueue_task(std::move(queued_task));
         m_impl->m_is_busy = true;
 
-        return;
+        return true;
+    }
+
+    m_impl->m_queue.push(std::move(queued_task));
+
+    return true;
+}
+
+bool TaskQueue::post_delayed(Task task, std::chrono::steady_clock::duration delay)
+{
+    if (delay <= Clock::duration::zero())
+    {
+        return post(std::move(task));
+    }
+
+    {
+        tbb::spin_mutex::scoped_lock lock(m_impl->m_mutex);
+
+        if (m_impl->m_is_closed)
+        {
+            return false;
+        }
     }
 
-    m_impl->m_queue.push(std::move(task));
+    m_impl->m_has_delayed_tasks.store(true, std::memory_order_release);
+    Timer::instance().schedule(*this, Clock::now() + delay, std::move(task));
+
+    return true;
+}
+
+void TaskQueue::drain()
+{
+    Impl::Lock lock(m_impl->m_mutex);
+
+    const auto target = m_impl->m_posted_count;
+
+    m_impl->wait(
+        lock,
+        [this, target]()
+        {
+            return m_impl->m_retired_count >= target;
+        });
+}
+
+bool TaskQueue::shutdown(std::chrono::milliseconds timeout)
+{
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+    Impl::Lock lock(m_impl->m_mutex);
+
+    m_impl->m_is_closed = true;
+
+    const bool is_drained = m_impl->wait_until(
+        lock,
+        deadline,
+        [this]()
+        {
+            return m_impl->m_retired_count == m_impl->m_posted_count;
+        });
+
+    if (!is_drained)
+    {
+        m_impl->discard_pending_tasks();
+    }
+
+    return is_drained;
+}
+
+TaskQueue::Scheduler TaskQueue::schedule() noexcept
+{
+    return Scheduler {*this};
+}
+
+void TaskQueue::enable_statistics(bool enable)
+{
+    tbb::spin_mutex::scoped_lock lock(m_impl->m_mutex);
+
+    if (enable && !m_impl->m_collect_statistics)
+    {
+        m_impl->reset_statistics();
+    }
+
+    m_impl->m_collect_statistics = enable;
+}
+
+TaskQueue::Statistics TaskQueue::statistics() const
+{
+    tbb::spin_mutex::scoped_lock lock(m_impl->m_mutex);
+
+    Statistics res = m_impl->m_statistics;
+    res.depth = m_impl->depth();
+
+    const std::chrono::duration<double> elapsed = Clock::now() - m_impl->m_statistics_started_at;
+    if (elapsed.count() > 0.0)
+    {
+        res.tasks_per_second = static_cast<double>(res.executed_count) / elapsed.count();
+    }
+
+    return res;
+}
+
+void TaskQueue::reset_statistics()
+{
+    tbb::spin_mutex::scoped_lock lock(m_impl->m_mutex);
+    m_impl->reset_statistics();
 }
 
 } // namespace foundation
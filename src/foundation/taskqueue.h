@@ -1,10 +1,23 @@
 #pragma once
 
+#include "foundation/histogram.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 
 namespace foundation
 {
 
+/**
+ *  Serial queue of tasks executed on TBB worker threads.
+ *
+ *  Tasks are executed one at a time in the order they were posted.
+ *  Destroying the queue discards the tasks that have not started yet
+ *  and blocks until the task currently being executed (if any) finishes,
+ *  so the queue must not be destroyed from a task running on it.
+ */
 class TaskQueue
 {
   public:
@@ -17,10 +30,77 @@ class TaskQueue
         High
     };
 
+    /**
+     *  Awaitable returned by schedule().
+     *  Awaiting it requires foundation/coroutine.h.
+     */
+    struct Scheduler
+    {
+        TaskQueue& queue;
+    };
+
+    /**
+     *  Queue statistics, durations are in nanoseconds.
+     */
+    struct Statistics
+    {
+        // Time from post() to the start of execution.
+        Histogram       wait_time;
+        Histogram       execution_time;
+
+        // Number of tasks either waiting or being executed.
+        std::size_t     depth;
+        std::size_t     max_depth;
+
+        std::uint64_t   executed_count;
+        double          tasks_per_second;
+    };
+
     TaskQueue(Priority priority = Priority::Normal);
     ~TaskQueue();
 
-    void post(Task task);
+    /**
+     *  Schedule task for execution.
+     *  Returns false, discarding the task, if the queue has been shut down.
+     */
+    bool post(Task task);
+
+    /**
+     *  Schedule task for execution once delay has elapsed.
+     *  Delayed tasks are handed over to the queue by a timer thread shared
+     *  by all queues, and are discarded if the queue is destroyed or shut
+     *  down first. drain() doesn't wait for the delayed tasks that are not
+     *  due yet. Returns false, discarding the task, if the queue has been
+     *  shut down.
+     */
+    bool post_delayed(Task task, std::chrono::steady_clock::duration delay);
+
+    /**
+     *  Block until every task posted before this call has finished.
+     *  Must not be called from a task running on this queue.
+     */
+    void drain();
+
+    /**
+     *  Stop accepting new tasks and wait for the posted ones to finish.
+     *  If the queue doesn't become idle within the timeout, the tasks
+     *  that have not started yet are discarded and false is returned.
+     *  Must not be called from a task running on this queue.
+     */
+    bool shutdown(std::chrono::milliseconds timeout);
+
+    /**
+     *  co_await queue.schedule() resumes the coroutine on this queue.
+     */
+    Scheduler schedule() noexcept;
+
+    /**
+     *  Statistics are collected only while enabled, which costs three
+     *  clock reads per task. Enabling resets the statistics.
+     */
+    void enable_statistics(bool enable);
+    Statistics statistics() const;
+    void reset_statistics();
 
   private:
     struct Impl;
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace foundation
+{
+
+using TypeId = std::uint64_t;
+
+namespace detail
+{
+
+constexpr std::uint64_t fnv1a(const char* str, std::size_t size) noexcept
+{
+    std::uint64_t hash = 14695981039346656037ull;
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        hash ^= static_cast<unsigned char>(str[i]);
+        hash *= 1099511628211ull;
+    }
+
+    return hash;
+}
+
+constexpr bool contains(const char* str, std::size_t size, const char* pattern, std::size_t pattern_size) noexcept
+{
+    for (std::size_t i = 0; i + pattern_size <= size; ++i)
+    {
+        std::size_t j = 0;
+        while (j < pattern_size && str[i + j] == pattern[j])
+        {
+            ++j;
+        }
+
+        if (j == pattern_size)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#define MORPH_FUNCTION_SIGNATURE __FUNCSIG__
+#else
+#define MORPH_FUNCTION_SIGNATURE __PRETTY_FUNCTION__
+#endif
+
+// The signature of the function names T.
+template <typename T>
+constexpr TypeId type_name_hash() noexcept
+{
+    return fnv1a(MORPH_FUNCTION_SIGNATURE, sizeof(MORPH_FUNCTION_SIGNATURE) - 1);
+}
+
+// Spelling of anonymous namespaces by gcc, clang and msvc.
+template <typename T>
+constexpr bool names_anonymous_namespace() noexcept
+{
+    constexpr const char* signature = MORPH_FUNCTION_SIGNATURE;
+    constexpr std::size_t size = sizeof(MORPH_FUNCTION_SIGNATURE) - 1;
+
+    return contains(signature, size, "{anonymous}", 11)
+        || contains(signature, size, "(anonymous namespace)", 21)
+        || contains(signature, size, "`anonymous namespace'", 21);
+}
+
+#undef MORPH_FUNCTION_SIGNATURE
+
+// Has internal linkage if T does, thus one per translation unit.
+template <typename T>
+inline char type_anchor = 0;
+
+} // namespace detail
+
+/**
+ *  Compile time identifier of T, computed from the name of the type,
+ *  so it is the same in every binary, unlike the address of a per-type
+ *  static with hidden visibility. Like typeid, references and cv
+ *  qualifiers are ignored and aliases name the same type.
+ *
+ *  Types of the same name in anonymous namespaces of different
+ *  translation units share their identifier, use unique_type_id()
+ *  where such types can meet.
+ */
+template <typename T>
+inline constexpr TypeId type_id = detail::type_name_hash<std::remove_cv_t<std::remove_reference_t<T>>>();
+
+/**
+ *  Whether T is, or is built from, a type declared in an anonymous namespace.
+ */
+template <typename T>
+inline constexpr bool is_anonymous_type = detail::names_anonymous_namespace<std::remove_cv_t<std::remove_reference_t<T>>>();
+
+/**
+ *  type_id<T>, except for anonymous types, which are identified by the
+ *  address of a per translation unit variable instead. Only a constant
+ *  expression for other types.
+ */
+template <typename T>
+constexpr TypeId unique_type_id() noexcept
+{
+    using U = std::remove_cv_t<std::remove_reference_t<T>>;
+
+    if constexpr (is_anonymous_type<U>)
+    {
+        return static_cast<TypeId>(reinterpret_cast<std::uintptr_t>(&detail::type_anchor<U>));
+    }
+    else
+    {
+        return type_id<U>;
+    }
+}
+
+} // namespace foundation
@@ -2,11 +2,63 @@
 
 #include <array>
 #include <cstddef>
+#include <type_traits>
 #include <utility>
 
+//
+//  The SSE overloads are constexpr and fall back to the generic code in
+//  constant expressions, which needs to detect constant evaluation.
+//
+
+#if defined(__cpp_lib_is_constant_evaluated)
+#define MORPH_IS_CONSTANT_EVALUATED() std::is_constant_evaluated()
+#elif defined(__clang__)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define MORPH_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+#elif (defined(__GNUC__) && __GNUC__ >= 9) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+#define MORPH_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+
+#if (defined(__SSE2__) || defined(_M_X64)) && defined(MORPH_IS_CONSTANT_EVALUATED)
+#define MORPH_VECTOR_SSE
+#include <emmintrin.h>
+#endif
+
 namespace foundation
 {
 
+namespace detail
+{
+
+// Vector3<float> may be padded to four floats (see the padded_vector3
+// build option), so that it can be SSE backed like Vector4<float>.
+template <typename Element>
+constexpr std::size_t vector3_storage_size = 3;
+
+template <typename Element>
+constexpr std::size_t vector3_alignment = alignof(Element);
+
+template <typename Element>
+constexpr std::size_t vector4_alignment = alignof(Element);
+
+#ifdef MORPH_VECTOR_SSE
+
+#ifdef MORPH_PADDED_VECTOR3
+template <>
+constexpr std::size_t vector3_storage_size<float> = 4;
+
+template <>
+constexpr std::size_t vector3_alignment<float> = 16;
+#endif
+
+template <>
+constexpr std::size_t vector4_alignment<float> = 16;
+
+#endif
+
+} // namespace detail
+
 //
 // Vector declaration.
 //
@@ -17,34 +69,52 @@ class Vector
   public:
     static constexpr std::size_t dimensions = Dimensions;
 
-    Element& operator[](const std::size_t i) noexcept;
-    const Element& operator[](const std::size_t i) const noexcept;
+    constexpr Element& operator[](const std::size_t i) noexcept;
+    constexpr const Element& operator[](const std::size_t i) const noexcept;
 
   private:
-    std::array<Element, Dimensions> m_data;
+    std::array<Element, Dimensions> m_data {};
 };
 
 template <std::size_t Dimensions, typename T>
-Vector<Dimensions, T> operator+(const Vector<Dimensions, T>& lhs, const Vector<Dimensions, T>& rhs) noexcept;
+constexpr Vector<Dimensions, T> operator+(const Vector<Dimensions, T>& lhs, const Vector<Dimensions, T>& rhs) noexcept;
 
 template <std::size_t Dimensions, typename T>
-Vector<Dimensions, T> operator-(const Vector<Dimensions, T>& lhs, const Vector<Dimensions, T>& rhs) noexcept;
+constexpr Vector<Dimensions, T> operator-(const Vector<Dimensions, T>& lhs, const Vector<Dimensions, T>& rhs) noexcept;
 
 template <std::size_t Dimensions, typename T>
-Vector<Dimensions, T> operator*(const Vector<Dimensions, T>& lhs, const T& rhs) noexcept;
+constexpr Vector<Dimensions, T> operator*(const Vector<Dimensions, T>& lhs, const T& rhs) noexcept;
 
 template <std::size_t Dimensions, typename T>
-Vector<Dimensions, T> operator-(const Vector<Dimensions, T>& v) noexcept;
+constexpr Vector<Dimensions, T> operator-(const Vector<Dimensions, T>& v) noexcept;
 
 template <std::size_t Dimensions, typename T>
-bool operator==(const Vector<Dimensions, T>& lhs, const Vector<Dimensions, T>& rhs) noexcept;
+constexpr bool operator==(const Vector<Dimensions, T>& lhs, const Vector<Dimensions, T>& rhs) noexcept;
 
 template <std::size_t Dimensions, typename T>
-bool operator!=(const Vector<Dimensions, T>& lhs, const Vector<Dimensions, T>& rhs) noexcept;
+constexpr bool operator!=(const Vector<Dimensions, T>& lhs, const Vector<Dimensions, T>& rhs) noexcept;
 
 
 template <std::size_t Dimensions, typename T>
-T dot_product(const Vector<Dimensions, T>& lhs, const Vector<Dimensions, T>& rhs) noexcept;
+constexpr T dot_product(const Vector<Dimensions, T>& lhs, const Vector<Dimensions, T>& rhs) noexcept;
+
+/**
+ *  a * factor + c, without the temporary of a * factor.
+ */
+template <std::size_t Dimensions, typename T>
+constexpr Vector<Dimensions, T> multiply_add(
+    const Vector<Dimensions, T>&    a,
+    const T&                        factor,
+    const Vector<Dimensions, T>&    c) noexcept;
+
+/**
+ *  Component-wise a * b + c.
+ */
+template <std::size_t Dimensions, typename T>
+constexpr Vector<Dimensions, T> multiply_add(
+    const Vector<Dimensions, T>&    a,
+    const Vector<Dimensions, T>&    b,
+    const Vector<Dimensions, T>&    c) noexcept;
 
 //
 // Vector2 declaration.
@@ -56,16 +126,16 @@ class Vector<2, Element>
   public:
     static constexpr std::size_t dimensions = 2;
 
-    Vector(Element x, Element y);
+    constexpr Vector(Element x, Element y);
 
-    Element& operator[](const std::size_t i) noexcept;
-    const Element& operator[](const std::size_t i) const noexcept;
+    constexpr Element& operator[](const std::size_t i) noexcept;
+    constexpr const Element& operator[](const std::size_t i) const noexcept;
 
-    Element& x() noexcept;
-    const Element& x() const noexcept;
+    constexpr Element& x() noexcept;
+    constexpr const Element& x() const noexcept;
 
-    Element& y() noexcept;
-    const Element& y() const noexcept;
+    constexpr Element& y() noexcept;
+    constexpr const Element& y() const noexcept;
 
   private:
     std::array<Element, 2> m_data;
@@ -86,22 +156,23 @@ class Vector<3, Element>
   public:
     static constexpr std::size_t dimensions = 3;
 
-    Vector(Element x, Element y, Element z);
+    constexpr Vector(Element x, Element y, Element z);
 
-    Element& operator[](const std::size_t i) noexcept;
-    const Element& operator[](const std::size_t i) const noexcept;
+    constexpr Element& operator[](const std::size_t i) noexcept;
+    constexpr const Element& operator[](const std::size_t i) const noexcept;
 
-    Element& x() noexcept;
-    const Element& x() const noexcept;
+    constexpr Element& x() noexcept;
+    constexpr const Element& x() const noexcept;
 
-    Element& y() noexcept;
-    const Element& y() const noexcept;
+    constexpr Element& y() noexcept;
+    constexpr const Element& y() const noexcept;
 
-    Element& z() noexcept;
-    const Element& z() const noexcept;
+    constexpr Element& z() noexcept;
+    constexpr const Element& z() const noexcept;
 
   private:
-      std::array<Element, 3> m_data;
+    alignas(detail::vector3_alignment<Element>)
+    std::array<Element, detail::vector3_storage_size<Element>> m_data;
 };
 
 template <typename Element>
@@ -110,26 +181,62 @@ using Vector3 = Vector<3, Element>;
 using Vector3f = Vector3<float>;
 
 template <typename T>
-Vector3<T> cross_product(const Vector3<T>& lhs, const Vector3<T>& rhs) noexcept;
+constexpr Vector3<T> cross_product(const Vector3<T>& lhs, const Vector3<T>& rhs) noexcept;
+
+//
+// Vector4 declaration.
+//
+
+template <typename Element>
+class Vector<4, Element>
+{
+  public:
+    static constexpr std::size_t dimensions = 4;
+
+    constexpr Vector(Element x, Element y, Element z, Element w);
+
+    constexpr Element& operator[](const std::size_t i) noexcept;
+    constexpr const Element& operator[](const std::size_t i) const noexcept;
+
+    constexpr Element& x() noexcept;
+    constexpr const Element& x() const noexcept;
+
+    constexpr Element& y() noexcept;
+    constexpr const Element& y() const noexcept;
+
+    constexpr Element& z() noexcept;
+    constexpr const Element& z() const noexcept;
+
+    constexpr Element& w() noexcept;
+    constexpr const Element& w() const noexcept;
+
+  private:
+    alignas(detail::vector4_alignment<Element>) std::array<Element, 4> m_data;
+};
+
+template <typename Element>
+using Vector4 = Vector<4, Element>;
+
+using Vector4f = Vector4<float>;
 
 //
 // Vector implementation.
 //
 
 template <std::size_t Dimensions, typename T>
-T& Vector<Dimensions, T>::operator[](const std::size_t i) noexcept
+constexpr T& Vector<Dimensions, T>::operator[](const std::size_t i) noexcept
 {
     return m_data[i];
 }
 
 template <std::size_t Dimensions, typename T>
-const T& Vector<Dimensions, T>::operator[](const std::size_t i) const noexcept
+constexpr const T& Vector<Dimensions, T>::operator[](const std::size_t i) const noexcept
 {
     return m_data[i];
 }
 
 template <std::size_t Dimensions, typename T>
-Vector<Dimensions, T> operator+(const Vector<Dimensions, T>& lhs, const Vector<Dimensions, T>& rhs) noexcept
+constexpr Vector<Dimensions, T> operator+(const Vector<Dimensions, T>& lhs, const Vector<Dimensions, T>& rhs) noexcept
 {
     auto res = lhs;
     for (std::size_t i = 0; i < Dimensions; ++i)
@@ -140,7 +247,7 @@ Vector<Dimensions, T> operator+(const Vector<Dimensions, T>& lhs, const Vector<D
 }
 
 template <std::size_t Dimensions, typename T>
-Vector<Dimensions, T> operator-(const Vector<Dimensions, T>& lhs, const Vector<Dimensions, T>& rhs) noexcept
+constexpr Vector<Dimensions, T> operator-(const Vector<Dimensions, T>& lhs, const Vector<Dimensions, T>& rhs) noexcept
 {
     auto res = lhs;
     for (std::size_t i = 0; i < Dimensions; ++i)
@@ -151,7 +258,7 @@ Vector<Dimensions, T> operator-(const Vector<Dimensions, T>& lhs, const Vector<D
 }
 
 template <std::size_t Dimensions, typename T>
-Vector<Dimensions, T> operator*(const Vector<Dimensions, T>& lhs, const T& rhs) noexcept
+constexpr Vector<Dimensions, T> operator*(const Vector<Dimensions, T>& lhs, const T& rhs) noexcept
 {
     auto res = lhs;
     for (std::size_t i = 0; i < Dimensions; ++i)
@@ -162,13 +269,13 @@ Vector<Dimensions, T> operator*(const Vector<Dimensions, T>& lhs, const T& rhs)
 }
 
 template <std::size_t Dimensions, typename T>
-Vector<Dimensions, T> operator-(const Vector<Dimensions, T>& v) noexcept
+constexpr Vector<Dimensions, T> operator-(const Vector<Dimensions, T>& v) noexcept
 {
-    return v * (-1.0f);
+    return v * T(-1);
 }
 
 template <std::size_t Dimensions, typename T>
-bool operator==(const Vector<Dimensions, T>& lhs, const Vector<Dimensions, T>& rhs) noexcept
+constexpr bool operator==(const Vector<Dimensions, T>& lhs, const Vector<Dimensions, T>& rhs) noexcept
 {
     for (std::size_t i = 0; i < Dimensions; ++i)
     {
@@ -181,13 +288,13 @@ bool operator==(const Vector<Dimensions, T>& lhs, const Vector<Dimensions, T>& r
 }
 
 template <std::size_t Dimensions, typename T>
-bool operator!=(const Vector<Dimensions, T>& lhs, const Vector<Dimensions, T>& rhs) noexcept
+constexpr bool operator!=(const Vector<Dimensions, T>& lhs, const Vector<Dimensions, T>& rhs) noexcept
 {
     return !(lhs == rhs);
 }
 
 template <std::size_t Dimensions, typename T>
-T dot_product(const Vector<Dimensions, T>& lhs, const Vector<Dimensions, T>& rhs) noexcept
+constexpr T dot_product(const Vector<Dimensions, T>& lhs, const Vector<Dimensions, T>& rhs) noexcept
 {
     T res = 0;
     for (std::size_t i = 0; i < Dimensions; ++i)
@@ -197,47 +304,96 @@ T dot_product(const Vector<Dimensions, T>& lhs, const Vector<Dimensions, T>& rhs
     return res;
 }
 
+namespace detail
+{
+
+// Unrolled, GCC keeps the loop over the components of multiply_add
+// and goes through the stack.
+template <std::size_t Dimensions, typename T, std::size_t... I>
+constexpr Vector<Dimensions, T> multiply_add(
+    const Vector<Dimensions, T>&    a,
+    const T&                        factor,
+    const Vector<Dimensions, T>&    c,
+    std::index_sequence<I...>) noexcept
+{
+    auto res = c;
+    ((res[I] = a[I] * factor + c[I]), ...);
+    return res;
+}
+
+template <std::size_t Dimensions, typename T, std::size_t... I>
+constexpr Vector<Dimensions, T> multiply_add(
+    const Vector<Dimensions, T>&    a,
+    const Vector<Dimensions, T>&    b,
+    const Vector<Dimensions, T>&    c,
+    std::index_sequence<I...>) noexcept
+{
+    auto res = c;
+    ((res[I] = a[I] * b[I] + c[I]), ...);
+    return res;
+}
+
+} // namespace detail
+
+template <std::size_t Dimensions, typename T>
+constexpr Vector<Dimensions, T> multiply_add(
+    const Vector<Dimensions, T>&    a,
+    const T&                        factor,
+    const Vector<Dimensions, T>&    c) noexcept
+{
+    return detail::multiply_add(a, factor, c, std::make_index_sequence<Dimensions> {});
+}
+
+template <std::size_t Dimensions, typename T>
+constexpr Vector<Dimensions, T> multiply_add(
+    const Vector<Dimensions, T>&    a,
+    const Vector<Dimensions, T>&    b,
+    const Vector<Dimensions, T>&    c) noexcept
+{
+    return detail::multiply_add(a, b, c, std::make_index_sequence<Dimensions> {});
+}
+
 //
 //  Vector2 implementation.
 //
 
 template <typename T>
-Vector<2, T>::Vector(T x, T y)
+constexpr Vector<2, T>::Vector(T x, T y)
   : m_data{ std::move(x), std::move(y) }
 {}
 
 template <typename T>
-T& Vector<2, T>::operator[](const std::size_t i) noexcept
+constexpr T& Vector<2, T>::operator[](const std::size_t i) noexcept
 {
     return m_data[i];
 }
 
 template <typename T>
-const T& Vector<2, T>::operator[](const std::size_t i) const noexcept
+constexpr const T& Vector<2, T>::operator[](const std::size_t i) const noexcept
 {
     return m_data[i];
 }
 
 template <typename T>
-T& Vector<2, T>::x() noexcept
+constexpr T& Vector<2, T>::x() noexcept
 {
     return m_data[0];
 }
 
 template <typename T>
-const T& Vector<2, T>::x() const noexcept
+constexpr const T& Vector<2, T>::x() const noexcept
 {
     return m_data[0];
 }
 
 template <typename T>
-T& Vector<2, T>::y() noexcept
+constexpr T& Vector<2, T>::y() noexcept
 {
     return m_data[1];
 }
 
 template <typename T>
-const T& Vector<2, T>::y() const noexcept
+constexpr const T& Vector<2, T>::y() const noexcept
 {
     return m_data[1];
 }
@@ -247,60 +403,60 @@ const T& Vector<2, T>::y() const noexcept
 //
 
 template <typename T>
-Vector<3, T>::Vector(T x, T y, T z)
+constexpr Vector<3, T>::Vector(T x, T y, T z)
   : m_data{std::move(x), std::move(y), std::move(z)}
 {}
 
 template <typename T>
-T& Vector<3, T>::operator[](const std::size_t i) noexcept
+constexpr T& Vector<3, T>::operator[](const std::size_t i) noexcept
 {
     return m_data[i];
 }
 
 template <typename T>
-const T& Vector<3, T>::operator[](const std::size_t i) const noexcept
+constexpr const T& Vector<3, T>::operator[](const std::size_t i) const noexcept
 {
     return m_data[i];
 }
 
 template <typename T>
-T& Vector<3, T>::x() noexcept
+constexpr T& Vector<3, T>::x() noexcept
 {
     return m_data[0];
 }
 
 template <typename T>
-const T& Vector<3, T>::x() const noexcept
+constexpr const T& Vector<3, T>::x() const noexcept
 {
     return m_data[0];
 }
 
 template <typename T>
-T& Vector<3, T>::y() noexcept
+constexpr T& Vector<3, T>::y() noexcept
 {
     return m_data[1];
 }
 
 template <typename T>
-const T& Vector<3, T>::y() const noexcept
+constexpr const T& Vector<3, T>::y() const noexcept
 {
     return m_data[1];
 }
 
 template <typename T>
-T& Vector<3, T>::z() noexcept
+constexpr T& Vector<3, T>::z() noexcept
 {
     return m_data[2];
 }
 
 template <typename T>
-const T& Vector<3, T>::z() const noexcept
+constexpr const T& Vector<3, T>::z() const noexcept
 {
     return m_data[2];
 }
 
 template <typename T>
-Vector3<T> cross_product(const Vector3<T>& a, const Vector3<T>& b) noexcept
+constexpr Vector3<T> cross_product(const Vector3<T>& a, const Vector3<T>& b) noexcept
 {
     return Vector3<T> {
         (a.y() * b.z()) - (a.z() * b.y()),
@@ -309,4 +465,333 @@ Vector3<T> cross_product(const Vector3<T>& a, const Vector3<T>& b) noexcept
     };
 }
 
+//
+//  Vector4 implementation.
+//
+
+template <typename T>
+constexpr Vector<4, T>::Vector(T x, T y, T z, T w)
+  : m_data{std::move(x), std::move(y), std::move(z), std::move(w)}
+{}
+
+template <typename T>
+constexpr T& Vector<4, T>::operator[](const std::size_t i) noexcept
+{
+    return m_data[i];
+}
+
+template <typename T>
+constexpr const T& Vector<4, T>::operator[](const std::size_t i) const noexcept
+{
+    return m_data[i];
+}
+
+template <typename T>
+constexpr T& Vector<4, T>::x() noexcept
+{
+    return m_data[0];
+}
+
+template <typename T>
+constexpr const T& Vector<4, T>::x() const noexcept
+{
+    return m_data[0];
+}
+
+template <typename T>
+constexpr T& Vector<4, T>::y() noexcept
+{
+    return m_data[1];
+}
+
+template <typename T>
+constexpr const T& Vector<4, T>::y() const noexcept
+{
+    return m_data[1];
+}
+
+template <typename T>
+constexpr T& Vector<4, T>::z() noexcept
+{
+    return m_data[2];
+}
+
+template <typename T>
+constexpr const T& Vector<4, T>::z() const noexcept
+{
+    return m_data[2];
+}
+
+template <typename T>
+constexpr T& Vector<4, T>::w() noexcept
+{
+    return m_data[3];
+}
+
+template <typename T>
+constexpr const T& Vector<4, T>::w() const noexcept
+{
+    return m_data[3];
+}
+
+#ifdef MORPH_VECTOR_SSE
+
+//
+//  SSE implementation of the float vectors.
+//
+//  Non-template overloads, preferred over the generic templates. The
+//  generic versions stay reachable with explicit template arguments,
+//  e.g. operator+<4, float>(a, b), and are used in constant expressions.
+//
+
+namespace detail
+{
+
+template <typename V>
+__m128 sse_load(const V& v) noexcept
+{
+    return _mm_load_ps(&v[0]);
+}
+
+template <typename V>
+V sse_store(__m128 v) noexcept
+{
+    V result = V(0.0f, 0.0f, 0.0f, 0.0f);
+    _mm_store_ps(&result[0], v);
+
+    return result;
+}
+
+inline float sse_horizontal_sum(__m128 v) noexcept
+{
+    auto shuffled = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+    auto sums = _mm_add_ps(v, shuffled);
+    shuffled = _mm_movehl_ps(shuffled, sums);
+    sums = _mm_add_ss(sums, shuffled);
+
+    return _mm_cvtss_f32(sums);
+}
+
+inline __m128 sse_sign_mask() noexcept
+{
+    return _mm_set1_ps(-0.0f);
+}
+
+inline __m128 sse_xyz_mask() noexcept
+{
+    return _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+}
+
+/**
+ *  Cross product of the x, y and z lanes, lane 3 is a3 * b3 - a3 * b3.
+ */
+inline __m128 sse_cross_product(__m128 a, __m128 b) noexcept
+{
+    const auto a_yzx = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+    const auto a_zxy = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 1, 0, 2));
+    const auto b_yzx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+    const auto b_zxy = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 1, 0, 2));
+
+    return _mm_sub_ps(_mm_mul_ps(a_yzx, b_zxy), _mm_mul_ps(a_zxy, b_yzx));
+}
+
+} // namespace detail
+
+constexpr Vector4f operator+(const Vector4f& lhs, const Vector4f& rhs) noexcept
+{
+    if (MORPH_IS_CONSTANT_EVALUATED())
+    {
+        return operator+<4, float>(lhs, rhs);
+    }
+    return detail::sse_store<Vector4f>(_mm_add_ps(detail::sse_load(lhs), detail::sse_load(rhs)));
+}
+
+constexpr Vector4f operator-(const Vector4f& lhs, const Vector4f& rhs) noexcept
+{
+    if (MORPH_IS_CONSTANT_EVALUATED())
+    {
+        return operator-<4, float>(lhs, rhs);
+    }
+    return detail::sse_store<Vector4f>(_mm_sub_ps(detail::sse_load(lhs), detail::sse_load(rhs)));
+}
+
+constexpr Vector4f operator*(const Vector4f& lhs, const float& rhs) noexcept
+{
+    if (MORPH_IS_CONSTANT_EVALUATED())
+    {
+        return operator*<4, float>(lhs, rhs);
+    }
+    return detail::sse_store<Vector4f>(_mm_mul_ps(detail::sse_load(lhs), _mm_set1_ps(rhs)));
+}
+
+constexpr Vector4f operator-(const Vector4f& v) noexcept
+{
+    if (MORPH_IS_CONSTANT_EVALUATED())
+    {
+        return operator-<4, float>(v);
+    }
+    return detail::sse_store<Vector4f>(_mm_xor_ps(detail::sse_load(v), detail::sse_sign_mask()));
+}
+
+constexpr bool operator==(const Vector4f& lhs, const Vector4f& rhs) noexcept
+{
+    if (MORPH_IS_CONSTANT_EVALUATED())
+    {
+        return operator==<4, float>(lhs, rhs);
+    }
+    return _mm_movemask_ps(_mm_cmpeq_ps(detail::sse_load(lhs), detail::sse_load(rhs))) == 0xf;
+}
+
+constexpr bool operator!=(const Vector4f& lhs, const Vector4f& rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+
+constexpr float dot_product(const Vector4f& lhs, const Vector4f& rhs) noexcept
+{
+    if (MORPH_IS_CONSTANT_EVALUATED())
+    {
+        return dot_product<4, float>(lhs, rhs);
+    }
+    return detail::sse_horizontal_sum(_mm_mul_ps(detail::sse_load(lhs), detail::sse_load(rhs)));
+}
+
+constexpr Vector4f multiply_add(const Vector4f& a, const float& factor, const Vector4f& c) noexcept
+{
+    if (MORPH_IS_CONSTANT_EVALUATED())
+    {
+        return multiply_add<4, float>(a, factor, c);
+    }
+    return detail::sse_store<Vector4f>(
+        _mm_add_ps(_mm_mul_ps(detail::sse_load(a), _mm_set1_ps(factor)), detail::sse_load(c)));
+}
+
+constexpr Vector4f multiply_add(const Vector4f& a, const Vector4f& b, const Vector4f& c) noexcept
+{
+    if (MORPH_IS_CONSTANT_EVALUATED())
+    {
+        return multiply_add<4, float>(a, b, c);
+    }
+    return detail::sse_store<Vector4f>(
+        _mm_add_ps(_mm_mul_ps(detail::sse_load(a), detail::sse_load(b)), detail::sse_load(c)));
+}
+
+#ifdef MORPH_PADDED_VECTOR3
+
+//
+//  The padding lane of Vector3f is kept at zero.
+//
+
+namespace detail
+{
+
+template <>
+inline Vector3f sse_store<Vector3f>(__m128 v) noexcept
+{
+    Vector3f result(0.0f, 0.0f, 0.0f);
+    _mm_store_ps(&result[0], v);
+
+    return result;
+}
+
+} // namespace detail
+
+constexpr Vector3f operator+(const Vector3f& lhs, const Vector3f& rhs) noexcept
+{
+    if (MORPH_IS_CONSTANT_EVALUATED())
+    {
+        return operator+<3, float>(lhs, rhs);
+    }
+    return detail::sse_store<Vector3f>(_mm_add_ps(detail::sse_load(lhs), detail::sse_load(rhs)));
+}
+
+constexpr Vector3f operator-(const Vector3f& lhs, const Vector3f& rhs) noexcept
+{
+    if (MORPH_IS_CONSTANT_EVALUATED())
+    {
+        return operator-<3, float>(lhs, rhs);
+    }
+    return detail::sse_store<Vector3f>(_mm_sub_ps(detail::sse_load(lhs), detail::sse_load(rhs)));
+}
+
+constexpr Vector3f operator*(const Vector3f& lhs, const float& rhs) noexcept
+{
+    if (MORPH_IS_CONSTANT_EVALUATED())
+    {
+        return operator*<3, float>(lhs, rhs);
+    }
+
+    // 0 * inf would turn the padding into a NaN.
+    return detail::sse_store<Vector3f>(
+        _mm_and_ps(_mm_mul_ps(detail::sse_load(lhs), _mm_set1_ps(rhs)), detail::sse_xyz_mask()));
+}
+
+constexpr Vector3f operator-(const Vector3f& v) noexcept
+{
+    if (MORPH_IS_CONSTANT_EVALUATED())
+    {
+        return operator-<3, float>(v);
+    }
+    return detail::sse_store<Vector3f>(_mm_xor_ps(detail::sse_load(v), detail::sse_sign_mask()));
+}
+
+constexpr bool operator==(const Vector3f& lhs, const Vector3f& rhs) noexcept
+{
+    if (MORPH_IS_CONSTANT_EVALUATED())
+    {
+        return operator==<3, float>(lhs, rhs);
+    }
+    return (_mm_movemask_ps(_mm_cmpeq_ps(detail::sse_load(lhs), detail::sse_load(rhs))) & 0x7) == 0x7;
+}
+
+constexpr bool operator!=(const Vector3f& lhs, const Vector3f& rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+
+constexpr float dot_product(const Vector3f& lhs, const Vector3f& rhs) noexcept
+{
+    if (MORPH_IS_CONSTANT_EVALUATED())
+    {
+        return dot_product<3, float>(lhs, rhs);
+    }
+    return detail::sse_horizontal_sum(_mm_mul_ps(detail::sse_load(lhs), detail::sse_load(rhs)));
+}
+
+constexpr Vector3f cross_product(const Vector3f& a, const Vector3f& b) noexcept
+{
+    if (MORPH_IS_CONSTANT_EVALUATED())
+    {
+        return cross_product<float>(a, b);
+    }
+
+    return detail::sse_store<Vector3f>(
+        detail::sse_cross_product(detail::sse_load(a), detail::sse_load(b)));
+}
+
+constexpr Vector3f multiply_add(const Vector3f& a, const float& factor, const Vector3f& c) noexcept
+{
+    if (MORPH_IS_CONSTANT_EVALUATED())
+    {
+        return multiply_add<3, float>(a, factor, c);
+    }
+
+    const auto product = _mm_and_ps(_mm_mul_ps(detail::sse_load(a), _mm_set1_ps(factor)), detail::sse_xyz_mask());
+    return detail::sse_store<Vector3f>(_mm_add_ps(product, detail::sse_load(c)));
+}
+
+constexpr Vector3f multiply_add(const Vector3f& a, const Vector3f& b, const Vector3f& c) noexcept
+{
+    if (MORPH_IS_CONSTANT_EVALUATED())
+    {
+        return multiply_add<3, float>(a, b, c);
+    }
+    return detail::sse_store<Vector3f>(
+        _mm_add_ps(_mm_mul_ps(detail::sse_load(a), detail::sse_load(b)), detail::sse_load(c)));
+}
+
+#endif // MORPH_PADDED_VECTOR3
+
+#endif // MORPH_VECTOR_SSE
+
 } // namespace foundation
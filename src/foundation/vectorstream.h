@@ -0,0 +1,503 @@
+#pragma once
+
+#include "foundation/vector.h"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace foundation
+{
+
+/**
+ *  Structure of arrays storage of vectors: each component is stored
+ *  in its own contiguous array, so batch operations process several
+ *  vectors per instruction (four floats with SSE).
+ *
+ *  Batch operations write into an output stream, which may be one of
+ *  the inputs. Throws std::invalid_argument if the input sizes differ.
+ */
+template <std::size_t Dimensions, typename Element>
+class VectorStream
+{
+  public:
+    using Value = Vector<Dimensions, Element>;
+
+    static constexpr std::size_t dimensions = Dimensions;
+
+    VectorStream() = default;
+
+    /**
+     *  Stream of size zero vectors.
+     */
+    explicit VectorStream(std::size_t size);
+
+    explicit VectorStream(const std::vector<Value>& values);
+
+    std::vector<Value> to_vector() const;
+
+    std::size_t size() const noexcept;
+
+    /**
+     *  New vectors are zero.
+     */
+    void resize(std::size_t size);
+
+    void push_back(const Value& value);
+
+    Value get(std::size_t i) const noexcept;
+    void set(std::size_t i, const Value& value) noexcept;
+
+    /**
+     *  Contiguous array of the d-th component of every vector.
+     */
+    Element* component(std::size_t d) noexcept;
+    const Element* component(std::size_t d) const noexcept;
+
+  private:
+    std::array<std::vector<Element>, Dimensions> m_components;
+};
+
+template <typename Element>
+using VectorStream3 = VectorStream<3, Element>;
+
+using VectorStream3f = VectorStream3<float>;
+
+/**
+ *  out[i] = a[i] + b[i]
+ */
+template <std::size_t Dimensions, typename T>
+void add(
+    const VectorStream<Dimensions, T>&  a,
+    const VectorStream<Dimensions, T>&  b,
+    VectorStream<Dimensions, T>&        out);
+
+/**
+ *  out[i] = a[i] - b[i]
+ */
+template <std::size_t Dimensions, typename T>
+void sub(
+    const VectorStream<Dimensions, T>&  a,
+    const VectorStream<Dimensions, T>&  b,
+    VectorStream<Dimensions, T>&        out);
+
+/**
+ *  out[i] = a[i] * factor
+ */
+template <std::size_t Dimensions, typename T>
+void scale(
+    const VectorStream<Dimensions, T>&  a,
+    T                                   factor,
+    VectorStream<Dimensions, T>&        out);
+
+/**
+ *  out[i] = dot_product(a[i], b[i])
+ */
+template <std::size_t Dimensions, typename T>
+void dot_product(
+    const VectorStream<Dimensions, T>&  a,
+    const VectorStream<Dimensions, T>&  b,
+    std::vector<T>&                     out);
+
+/**
+ *  out[i] = cross_product(a[i], b[i])
+ */
+template <typename T>
+void cross_product(
+    const VectorStream3<T>&             a,
+    const VectorStream3<T>&             b,
+    VectorStream3<T>&                   out);
+
+/**
+ *  out[i] = a[i] / |a[i]|, zero vectors become NaN.
+ */
+template <std::size_t Dimensions, typename T>
+void normalize(
+    const VectorStream<Dimensions, T>&  a,
+    VectorStream<Dimensions, T>&        out);
+
+/**
+ *  Affine transform: out[i][r] = dot_product(rows[r], a[i]) + translation[r].
+ */
+template <std::size_t Dimensions, typename T>
+void transform(
+    const VectorStream<Dimensions, T>&                  a,
+    const std::array<Vector<Dimensions, T>, Dimensions>& rows,
+    const Vector<Dimensions, T>&                        translation,
+    VectorStream<Dimensions, T>&                        out);
+
+//
+// Lanes: the batch operations are written once against a set of
+// operations on a register holding one or several elements.
+//
+
+namespace detail
+{
+
+template <typename T>
+struct ScalarLanes
+{
+    using Register = T;
+
+    static Register load(const T* p) noexcept { return *p; }
+    static void store(T* p, Register v) noexcept { *p = v; }
+    static Register broadcast(T v) noexcept { return v; }
+    static Register add(Register a, Register b) noexcept { return a + b; }
+    static Register sub(Register a, Register b) noexcept { return a - b; }
+    static Register mul(Register a, Register b) noexcept { return a * b; }
+    static Register div(Register a, Register b) noexcept { return a / b; }
+    static Register sqrt(Register a) noexcept { return std::sqrt(a); }
+};
+
+#ifdef MORPH_VECTOR_SSE
+
+struct SseLanes
+{
+    using Register = __m128;
+
+    static Register load(const float* p) noexcept { return _mm_loadu_ps(p); }
+    static void store(float* p, Register v) noexcept { _mm_storeu_ps(p, v); }
+    static Register broadcast(float v) noexcept { return _mm_set1_ps(v); }
+    static Register add(Register a, Register b) noexcept { return _mm_add_ps(a, b); }
+    static Register sub(Register a, Register b) noexcept { return _mm_sub_ps(a, b); }
+    static Register mul(Register a, Register b) noexcept { return _mm_mul_ps(a, b); }
+    static Register div(Register a, Register b) noexcept { return _mm_div_ps(a, b); }
+    static Register sqrt(Register a) noexcept { return _mm_sqrt_ps(a); }
+};
+
+#endif
+
+/**
+ *  Call kernel(lanes, i) for i = 0, 4, 8... with SseLanes for floats,
+ *  then for the remaining i with ScalarLanes.
+ */
+template <typename T, typename Kernel>
+void for_each_batch(std::size_t size, Kernel&& kernel)
+{
+    std::size_t i = 0;
+
+#ifdef MORPH_VECTOR_SSE
+    if constexpr (std::is_same_v<T, float>)
+    {
+        for (; i + 4 <= size; i += 4)
+        {
+            kernel(SseLanes {}, i);
+        }
+    }
+#endif
+
+    for (; i < size; ++i)
+    {
+        kernel(ScalarLanes<T> {}, i);
+    }
+}
+
+template <typename Stream>
+void check_sizes(const Stream& a, std::size_t size)
+{
+    if (a.size() != size)
+    {
+        throw std::invalid_argument("Vector streams of different sizes.");
+    }
+}
+
+template <std::size_t Dimensions, typename T, typename Lanes>
+typename Lanes::Register dot_product(
+    Lanes,
+    const VectorStream<Dimensions, T>&  a,
+    const VectorStream<Dimensions, T>&  b,
+    std::size_t                         i)
+{
+    auto sum = Lanes::mul(Lanes::load(a.component(0) + i), Lanes::load(b.component(0) + i));
+
+    for (std::size_t d = 1; d < Dimensions; ++d)
+    {
+        sum = Lanes::add(sum, Lanes::mul(Lanes::load(a.component(d) + i), Lanes::load(b.component(d) + i)));
+    }
+
+    return sum;
+}
+
+} // namespace detail
+
+//
+// VectorStream implementation.
+//
+
+template <std::size_t Dimensions, typename T>
+VectorStream<Dimensions, T>::VectorStream(std::size_t size)
+{
+    resize(size);
+}
+
+template <std::size_t Dimensions, typename T>
+VectorStream<Dimensions, T>::VectorStream(const std::vector<Value>& values)
+{
+    for (std::size_t d = 0; d < Dimensions; ++d)
+    {
+        auto& component = m_components[d];
+        component.resize(values.size());
+
+        for (std::size_t i = 0; i < values.size(); ++i)
+        {
+            component[i] = values[i][d];
+        }
+    }
+}
+
+template <std::size_t Dimensions, typename T>
+std::vector<Vector<Dimensions, T>> VectorStream<Dimensions, T>::to_vector() const
+{
+    std::vector<Value> result;
+    result.reserve(size());
+
+    for (std::size_t i = 0; i < size(); ++i)
+    {
+        result.push_back(get(i));
+    }
+
+    return result;
+}
+
+template <std::size_t Dimensions, typename T>
+std::size_t VectorStream<Dimensions, T>::size() const noexcept
+{
+    return m_components[0].size();
+}
+
+template <std::size_t Dimensions, typename T>
+void VectorStream<Dimensions, T>::resize(std::size_t size)
+{
+    for (auto& component : m_components)
+    {
+        component.resize(size, T(0));
+    }
+}
+
+template <std::size_t Dimensions, typename T>
+void VectorStream<Dimensions, T>::push_back(const Value& value)
+{
+    for (std::size_t d = 0; d < Dimensions; ++d)
+    {
+        m_components[d].push_back(value[d]);
+    }
+}
+
+template <std::size_t Dimensions, typename T>
+Vector<Dimensions, T> VectorStream<Dimensions, T>::get(std::size_t i) const noexcept
+{
+    if constexpr (std::is_default_constructible_v<Value>)
+    {
+        Value result;
+
+        for (std::size_t d = 0; d < Dimensions; ++d)
+        {
+            result[d] = m_components[d][i];
+        }
+
+        return result;
+    }
+    else
+    {
+        // Vector2, Vector3 and Vector4 are built from their components.
+        return std::apply(
+            [i](const auto&... components)
+            {
+                return Value(components[i]...);
+            },
+            m_components);
+    }
+}
+
+template <std::size_t Dimensions, typename T>
+void VectorStream<Dimensions, T>::set(std::size_t i, const Value& value) noexcept
+{
+    for (std::size_t d = 0; d < Dimensions; ++d)
+    {
+        m_components[d][i] = value[d];
+    }
+}
+
+template <std::size_t Dimensions, typename T>
+T* VectorStream<Dimensions, T>::component(std::size_t d) noexcept
+{
+    return m_components[d].data();
+}
+
+template <std::size_t Dimensions, typename T>
+const T* VectorStream<Dimensions, T>::component(std::size_t d) const noexcept
+{
+    return m_components[d].data();
+}
+
+//
+// Batch operations implementation.
+//
+
+template <std::size_t Dimensions, typename T>
+void add(
+    const VectorStream<Dimensions, T>&  a,
+    const VectorStream<Dimensions, T>&  b,
+    VectorStream<Dimensions, T>&        out)
+{
+    detail::check_sizes(b, a.size());
+    out.resize(a.size());
+
+    detail::for_each_batch<T>(a.size(), [&](auto lanes, std::size_t i)
+    {
+        using Lanes = decltype(lanes);
+
+        for (std::size_t d = 0; d < Dimensions; ++d)
+        {
+            Lanes::store(
+                out.component(d) + i,
+                Lanes::add(Lanes::load(a.component(d) + i), Lanes::load(b.component(d) + i)));
+        }
+    });
+}
+
+template <std::size_t Dimensions, typename T>
+void sub(
+    const VectorStream<Dimensions, T>&  a,
+    const VectorStream<Dimensions, T>&  b,
+    VectorStream<Dimensions, T>&        out)
+{
+    detail::check_sizes(b, a.size());
+    out.resize(a.size());
+
+    detail::for_each_batch<T>(a.size(), [&](auto lanes, std::size_t i)
+    {
+        using Lanes = decltype(lanes);
+
+        for (std::size_t d = 0; d < Dimensions; ++d)
+        {
+            Lanes::store(
+                out.component(d) + i,
+                Lanes::sub(Lanes::load(a.component(d) + i), Lanes::load(b.component(d) + i)));
+        }
+    });
+}
+
+template <std::size_t Dimensions, typename T>
+void scale(
+    const VectorStream<Dimensions, T>&  a,
+    T                                   factor,
+    VectorStream<Dimensions, T>&        out)
+{
+    out.resize(a.size());
+
+    detail::for_each_batch<T>(a.size(), [&](auto lanes, std::size_t i)
+    {
+        using Lanes = decltype(lanes);
+
+        const auto f = Lanes::broadcast(factor);
+
+        for (std::size_t d = 0; d < Dimensions; ++d)
+        {
+            Lanes::store(out.component(d) + i, Lanes::mul(Lanes::load(a.component(d) + i), f));
+        }
+    });
+}
+
+template <std::size_t Dimensions, typename T>
+void dot_product(
+    const VectorStream<Dimensions, T>&  a,
+    const VectorStream<Dimensions, T>&  b,
+    std::vector<T>&                     out)
+{
+    detail::check_sizes(b, a.size());
+    out.resize(a.size());
+
+    detail::for_each_batch<T>(a.size(), [&](auto lanes, std::size_t i)
+    {
+        using Lanes = decltype(lanes);
+        Lanes::store(out.data() + i, detail::dot_product(lanes, a, b, i));
+    });
+}
+
+template <typename T>
+void cross_product(
+    const VectorStream3<T>&             a,
+    const VectorStream3<T>&             b,
+    VectorStream3<T>&                   out)
+{
+    detail::check_sizes(b, a.size());
+    out.resize(a.size());
+
+    detail::for_each_batch<T>(a.size(), [&](auto lanes, std::size_t i)
+    {
+        using Lanes = decltype(lanes);
+
+        const auto ax = Lanes::load(a.component(0) + i);
+        const auto ay = Lanes::load(a.component(1) + i);
+        const auto az = Lanes::load(a.component(2) + i);
+        const auto bx = Lanes::load(b.component(0) + i);
+        const auto by = Lanes::load(b.component(1) + i);
+        const auto bz = Lanes::load(b.component(2) + i);
+
+        Lanes::store(out.component(0) + i, Lanes::sub(Lanes::mul(ay, bz), Lanes::mul(az, by)));
+        Lanes::store(out.component(1) + i, Lanes::sub(Lanes::mul(az, bx), Lanes::mul(ax, bz)));
+        Lanes::store(out.component(2) + i, Lanes::sub(Lanes::mul(ax, by), Lanes::mul(ay, bx)));
+    });
+}
+
+template <std::size_t Dimensions, typename T>
+void normalize(
+    const VectorStream<Dimensions, T>&  a,
+    VectorStream<Dimensions, T>&        out)
+{
+    out.resize(a.size());
+
+    detail::for_each_batch<T>(a.size(), [&](auto lanes, std::size_t i)
+    {
+        using Lanes = decltype(lanes);
+
+        const auto length = Lanes::sqrt(detail::dot_product(lanes, a, a, i));
+
+        for (std::size_t d = 0; d < Dimensions; ++d)
+        {
+            Lanes::store(out.component(d) + i, Lanes::div(Lanes::load(a.component(d) + i), length));
+        }
+    });
+}
+
+template <std::size_t Dimensions, typename T>
+void transform(
+    const VectorStream<Dimensions, T>&                  a,
+    const std::array<Vector<Dimensions, T>, Dimensions>& rows,
+    const Vector<Dimensions, T>&                        translation,
+    VectorStream<Dimensions, T>&                        out)
+{
+    out.resize(a.size());
+
+    detail::for_each_batch<T>(a.size(), [&](auto lanes, std::size_t i)
+    {
+        using Lanes = decltype(lanes);
+
+        typename Lanes::Register in[Dimensions];
+
+        for (std::size_t c = 0; c < Dimensions; ++c)
+        {
+            in[c] = Lanes::load(a.component(c) + i);
+        }
+
+        // out may be a, all the components are loaded first.
+        for (std::size_t r = 0; r < Dimensions; ++r)
+        {
+            auto sum = Lanes::broadcast(translation[r]);
+
+            for (std::size_t c = 0; c < Dimensions; ++c)
+            {
+                sum = Lanes::add(sum, Lanes::mul(Lanes::broadcast(rows[r][c]), in[c]));
+            }
+
+            Lanes::store(out.component(r) + i, sum);
+        }
+    });
+}
+
+} // namespace foundation
@@ -277,6 +277,34 @@ struct Loader<T, typename std::enable_if_t<std::is_integral<T>::value>>
 };
 
 
+//
+//  Floating point types specialization.
+//
+
+template<typename T>
+struct Caster<T, typename std::enable_if_t<std::is_floating_point<T>::value>>
+{
+    static Handle cast(T* src, return_value_policy)
+    {
+        return PyFloat_FromDouble(static_cast<double>(*src));
+    }
+};
+
+template<typename T>
+struct Loader<T, typename std::enable_if_t<std::is_floating_point<T>::value>>
+{
+    static T load(Handle from)
+    {
+        if (PyFloat_Check(from.ptr()) || PyLong_Check(from.ptr()))
+        {
+            return static_cast<T>(PyFloat_AsDouble(from.ptr()));
+        }
+
+        throw LoadError {};
+    }
+};
+
+
 //
 //  std::string specialization.
 //
@@ -337,6 +365,22 @@ struct Loader<bool>
     }
 };
 
+//
+//  Python objects, loaded with a new reference.
+//
+
+template<>
+struct Loader<Object>
+{
+    static Object load(Handle from)
+    {
+        Object res(from.ptr());
+        res.inc_ref();
+
+        return res;
+    }
+};
+
 template <typename T>
 Handle cast(T&& src, return_value_policy ret_val_policy)
 {
@@ -0,0 +1,207 @@
+#include "foundation/histogram.h"
+#include "foundation/taskqueue.h"
+
+#include "python/cast.h"
+#include "python/class.h"
+#include "python/module.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace foundation
+{
+namespace
+{
+
+/**
+ *  TaskQueue running python callables, for instance to observe its
+ *  statistics from python. Tasks take the GIL on the worker thread,
+ *  so the GIL is released while blocking on the queue.
+ */
+class PythonTaskQueue
+{
+  public:
+    PythonTaskQueue()
+      : m_queue(std::make_unique<TaskQueue>())
+    {}
+
+    PythonTaskQueue(const PythonTaskQueue&) = delete;
+    PythonTaskQueue& operator=(const PythonTaskQueue&) = delete;
+
+    ~PythonTaskQueue()
+    {
+        Py_BEGIN_ALLOW_THREADS
+        m_queue.reset();
+        Py_END_ALLOW_THREADS
+    }
+
+    bool post(py::Object fn)
+    {
+        // Tasks may be destroyed on a worker thread.
+        std::shared_ptr<PyObject> callable(
+            fn.release().ptr(),
+            [](PyObject* obj)
+            {
+                const auto state = PyGILState_Ensure();
+                Py_DECREF(obj);
+                PyGILState_Release(state);
+            });
+
+        auto task = [callable]()
+        {
+            const auto state = PyGILState_Ensure();
+
+            if (PyObject* res = PyObject_CallObject(callable.get(), nullptr))
+            {
+                Py_DECREF(res);
+            }
+            else
+            {
+                PyErr_WriteUnraisable(callable.get());
+            }
+
+            PyGILState_Release(state);
+        };
+
+        bool is_posted;
+
+        Py_BEGIN_ALLOW_THREADS
+        is_posted = m_queue->post(std::move(task));
+        Py_END_ALLOW_THREADS
+
+        return is_posted;
+    }
+
+    void drain()
+    {
+        Py_BEGIN_ALLOW_THREADS
+        m_queue->drain();
+        Py_END_ALLOW_THREADS
+    }
+
+    TaskQueue& queue() noexcept
+    {
+        return *m_queue;
+    }
+
+  private:
+    std::unique_ptr<TaskQueue> m_queue;
+};
+
+} // namespace
+
+MORPH_PYTHON_MODULE(_foundation, m, Morph Python foundation module)
+{
+    py::ExposeClass<Histogram>(m, "Histogram")
+        .def(py::Init<>())
+        .def(
+            "count",
+            [](const Histogram& h) -> std::uint64_t
+            {
+                return h.count();
+            })
+        .def(
+            "bucket",
+            [](const Histogram& h, std::size_t i) -> std::uint64_t
+            {
+                return i < Histogram::buckets_count ? h.bucket(i) : 0u;
+            })
+        .def(
+            "buckets_count",
+            [](const Histogram&) -> std::size_t
+            {
+                return Histogram::buckets_count;
+            })
+        .def(
+            "max",
+            [](const Histogram& h) -> std::uint64_t
+            {
+                return h.max();
+            })
+        .def(
+            "mean",
+            [](const Histogram& h) -> std::uint64_t
+            {
+                return h.mean();
+            })
+        .def(
+            "percentile",
+            [](const Histogram& h, double p) -> std::uint64_t
+            {
+                return h.percentile(p);
+            });
+
+    py::ExposeClass<TaskQueue::Statistics>(m, "TaskQueueStatistics")
+        .def(
+            "wait_time",
+            [](const TaskQueue::Statistics& s) -> Histogram
+            {
+                return s.wait_time;
+            })
+        .def(
+            "execution_time",
+            [](const TaskQueue::Statistics& s) -> Histogram
+            {
+                return s.execution_time;
+            })
+        .def(
+            "depth",
+            [](const TaskQueue::Statistics& s) -> std::size_t
+            {
+                return s.depth;
+            })
+        .def(
+            "max_depth",
+            [](const TaskQueue::Statistics& s) -> std::size_t
+            {
+                return s.max_depth;
+            })
+        .def(
+            "executed_count",
+            [](const TaskQueue::Statistics& s) -> std::uint64_t
+            {
+                return s.executed_count;
+            })
+        .def(
+            "tasks_per_second",
+            [](const TaskQueue::Statistics& s) -> double
+            {
+                return s.tasks_per_second;
+            });
+
+    py::ExposeClass<PythonTaskQueue>(m, "TaskQueue")
+        .def(py::Init<>())
+        .def(
+            "post",
+            [](PythonTaskQueue& q, py::Object fn) -> bool
+            {
+                return q.post(std::move(fn));
+            })
+        .def(
+            "drain",
+            [](PythonTaskQueue& q) -> void
+            {
+                q.drain();
+            })
+        .def(
+            "enable_statistics",
+            [](PythonTaskQueue& q, bool enable) -> void
+            {
+                q.queue().enable_statistics(enable);
+            })
+        .def(
+            "statistics",
+            [](PythonTaskQueue& q) -> TaskQueue::Statistics
+            {
+                return q.queue().statistics();
+            })
+        .def(
+            "reset_statistics",
+            [](PythonTaskQueue& q) -> void
+            {
+                q.queue().reset_statistics();
+            });
+}
+
+} // namespace foundation
@@ -43,7 +43,7 @@ template <typename Fn>
 struct FnSignatureFromLambdaT
 {
     using OperatorType = decltype(&Fn::operator());
-    using Type = typename FnSignatureFromLambdaImpl<OperatorType>::type;
+    using Type = typename FnSignatureFromLambdaImpl<OperatorType>::Type;
 };
 
 
@@ -226,7 +226,7 @@ class CppFunction
             std::move(scope),
             policy,
             std::forward<Fn>(fn),
-            typename FnSignatureFromLambdaT<Fn>::type {});
+            typename FnSignatureFromLambdaT<std::decay_t<Fn>>::Type {});
     }
 
     /**
@@ -0,0 +1,98 @@
+#include "core/binarylogrecord.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+
+using namespace testing;
+using namespace core;
+
+namespace
+{
+
+template <typename... Args>
+std::string format_args(const char* format_string, const Args&... args)
+{
+    BinaryLogRecord record;
+    capture(record, format_string, args...);
+
+    return format(record);
+}
+
+} // namespace
+
+TEST(binary_log_record, plain_text)
+{
+    ASSERT_EQ(format_args("no arguments"), "no arguments");
+    ASSERT_EQ(format_args("100%% done"), "100% done");
+    ASSERT_EQ(format_args(""), "");
+}
+
+TEST(binary_log_record, integers)
+{
+    ASSERT_EQ(format_args("%d %i", -5, 7), "-5 7");
+    ASSERT_EQ(format_args("%u", 42u), "42");
+    ASSERT_EQ(format_args("%x %X %o", 255, 255u, 8), "ff FF 10");
+    ASSERT_EQ(format_args("%lld", std::int64_t(-1234567890123)), "-1234567890123");
+    ASSERT_EQ(format_args("%llu", std::uint64_t(18446744073709551615ull)), "18446744073709551615");
+    ASSERT_EQ(format_args("%c%c", 'o', 'k'), "ok");
+    ASSERT_EQ(format_args("%5d|%-5d|%05d", 1, 2, 3), "    1|2    |00003");
+}
+
+TEST(binary_log_record, floating_point)
+{
+    ASSERT_EQ(format_args("%.2f", 3.14159), "3.14");
+    ASSERT_EQ(format_args("%.1f", 2.5f), "2.5");
+    ASSERT_EQ(format_args("%g", 1e10), "1e+10");
+}
+
+TEST(binary_log_record, strings)
+{
+    const std::string s = "world";
+    const char* c = "hello";
+
+    ASSERT_EQ(format_args("%s, %s!", c, s), "hello, world!");
+    ASSERT_EQ(format_args("[%8s]", "abc"), "[     abc]");
+}
+
+TEST(binary_log_record, null_strings)
+{
+    const char* null_str = nullptr;
+    char* null_mutable_str = nullptr;
+
+    ASSERT_EQ(format_args("[%s]", null_str), "[(null)]");
+    ASSERT_EQ(format_args("%s %s", null_mutable_str, "ok"), "(null) ok");
+}
+
+TEST(binary_log_record, strings_are_copied)
+{
+    BinaryLogRecord record;
+
+    {
+        std::string s = "temporary";
+        capture(record, "%s", s);
+        s = "overwritten";
+    }
+
+    ASSERT_EQ(format(record), "temporary");
+}
+
+TEST(binary_log_record, long_strings_are_truncated)
+{
+    const std::string a(100, 'a');
+    const std::string b = "b";
+
+    const auto result = format_args("%s|%s", a, b);
+
+    ASSERT_EQ(result, std::string(BinaryLogRecord::text_capacity - 1u, 'a') + "|");
+}
+
+TEST(binary_log_record, mismatched_arguments)
+{
+    ASSERT_EQ(format_args("%d %d", 1), "1 (missing argument)");
+    ASSERT_EQ(format_args("%s", 1), "(not a string)");
+    ASSERT_EQ(format_args("%d", 1, 2), "1");
+    ASSERT_EQ(format_args("%f", 3), "3.000000");
+}
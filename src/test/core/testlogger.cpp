@@ -1,6 +1,11 @@
 #include "core/logger.h"
 
+#include <zlib.h>
+
+#include <cstdio>
+#include <future>
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <thread>
 #include <vector>
@@ -54,3 +59,395 @@ TEST(logger_test, working_logger)
 
     std::this_thread::sleep_for(0.1s);
 }
+
+TEST(logger_test, queue_statistics)
+{
+    auto a = Logger::create();
+    a->enable_queue_statistics(true);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        a->log(Severity::Info, "record");
+    }
+
+    std::this_thread::sleep_for(0.1s);
+
+    auto stats = a->queue_statistics();
+    ASSERT_EQ(stats.executed_count, 10u);
+    ASSERT_EQ(stats.wait_time.count(), 10u);
+}
+
+TEST(logger_test, snapshots_are_persistent)
+{
+    auto a = Logger::create();
+
+    vector<State> snapshots;
+    auto un = a->subscribe(
+        [&snapshots](const State& state)
+        {
+            snapshots.push_back(state);
+        });
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        a->log(Severity::Info, to_string(i));
+    }
+
+    a->flush();
+
+    ASSERT_EQ(snapshots.size(), 1000u);
+    for (size_t i = 0; i < snapshots.size(); ++i)
+    {
+        ASSERT_EQ(snapshots[i].size(), i + 1);
+        ASSERT_EQ(snapshots[i].back().message, to_string(i));
+        ASSERT_EQ(snapshots[i].front().message, "0");
+    }
+}
+
+TEST(logger_test, retention_by_records)
+{
+    RetentionPolicy retention;
+    retention.max_records = 10;
+
+    auto a = Logger::create(retention);
+
+    State last;
+    auto un = a->subscribe(
+        [&last](const State& state)
+        {
+            ASSERT_LE(state.size(), 10u);
+            last = state;
+        });
+
+    for (int i = 0; i < 100; ++i)
+    {
+        a->log(Severity::Info, to_string(i));
+    }
+
+    a->flush();
+
+    ASSERT_EQ(last.size(), 10u);
+    for (size_t i = 0; i < last.size(); ++i)
+    {
+        ASSERT_EQ(last[i].message, to_string(90 + i));
+    }
+}
+
+TEST(logger_test, retention_by_bytes)
+{
+    const string message(1000, 'x');
+
+    RetentionPolicy retention;
+    retention.max_bytes = 10 * (sizeof(LogRecord) + message.size());
+
+    auto a = Logger::create(retention);
+
+    State last;
+    auto un = a->subscribe(
+        [&last](const State& state)
+        {
+            last = state;
+        });
+
+    for (int i = 0; i < 100; ++i)
+    {
+        a->log(Severity::Info, message);
+    }
+
+    a->flush();
+
+    ASSERT_EQ(last.size(), 10u);
+
+    // A single record over the limit is still kept.
+    a->log(Severity::Info, string(retention.max_bytes, 'y'));
+    a->flush();
+
+    ASSERT_EQ(last.size(), 1u);
+    ASSERT_EQ(last.back().message.size(), retention.max_bytes);
+}
+
+TEST(logger_test, retention_spills_evicted_records)
+{
+    const string path = testing::TempDir() + "morph_logger_spill.gz";
+    std::remove(path.c_str());
+
+    {
+        RetentionPolicy retention;
+        retention.max_records = 5;
+        retention.spill_path = path;
+
+        auto a = Logger::create(retention);
+
+        for (int i = 0; i < 20; ++i)
+        {
+            a->log(i % 2 ? Severity::Warning : Severity::Info, "record " + to_string(i));
+        }
+
+        a->flush();
+    }
+
+    auto file = gzopen(path.c_str(), "rb");
+    ASSERT_NE(file, nullptr);
+
+    vector<string> lines;
+    char buffer[256];
+    while (gzgets(file, buffer, sizeof(buffer)) != nullptr)
+    {
+        lines.emplace_back(buffer);
+    }
+    gzclose(file);
+    std::remove(path.c_str());
+
+    ASSERT_EQ(lines.size(), 15u);
+    for (size_t i = 0; i < lines.size(); ++i)
+    {
+        const auto expected = string(i % 2 ? " warning " : " info ") + "record " + to_string(i) + "\n";
+        ASSERT_THAT(lines[i], EndsWith(expected));
+    }
+}
+
+TEST(logger_test, spill_file_open_failure)
+{
+    RetentionPolicy retention;
+    retention.spill_path = "/nonexistent/directory/spill.gz";
+
+    ASSERT_THROW(Logger::create(retention), std::runtime_error);
+}
+
+TEST(logger_test, logf_formats_on_queue)
+{
+    auto a = Logger::create();
+
+    State last;
+    auto un = a->subscribe(
+        [&last](const State& state)
+        {
+            last = state;
+        });
+
+    a->logf(Severity::Warning, "%s %d of %.1f", "record", 1, 2.0);
+    a->flush();
+
+    ASSERT_EQ(last.size(), 1u);
+    ASSERT_EQ(last[0].message, "record 1 of 2.0");
+    ASSERT_EQ(last[0].severity, Severity::Warning);
+}
+
+TEST(logger_test, logf_from_several_threads)
+{
+    constexpr int threads_count = 4;
+    constexpr int records_count = 5000;
+
+    auto a = Logger::create();
+
+    State last;
+    auto un = a->subscribe(
+        [&last](const State& state)
+        {
+            last = state;
+        });
+
+    vector<thread> threads;
+    for (int t = 0; t < threads_count; ++t)
+    {
+        threads.emplace_back([&a, t]()
+            {
+                for (int i = 0; i < records_count; ++i)
+                {
+                    a->logf(Severity::Info, "%d %d", t, i);
+                }
+            });
+    }
+
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+
+    a->flush();
+
+    ASSERT_EQ(last.size(), static_cast<size_t>(threads_count * records_count));
+
+    // Records of every thread keep their order.
+    vector<int> next(threads_count, 0);
+    for (const auto& record : last)
+    {
+        int t = 0;
+        int i = 0;
+        ASSERT_EQ(sscanf(record.message.c_str(), "%d %d", &t, &i), 2);
+        ASSERT_EQ(i, next[t]++);
+    }
+}
+
+TEST(logger_test, logf_to_successive_loggers)
+{
+    for (int i = 0; i < 10; ++i)
+    {
+        auto a = Logger::create();
+
+        State last;
+        auto un = a->subscribe(
+            [&last](const State& state)
+            {
+                last = state;
+            });
+
+        a->logf(Severity::Info, "logger %d", i);
+        a->flush();
+
+        ASSERT_EQ(last.size(), 1u);
+        ASSERT_EQ(last[0].message, "logger " + to_string(i));
+    }
+}
+
+TEST(logger_test, min_severity)
+{
+    auto a = Logger::create();
+    a->set_min_severity(Severity::Warning);
+
+    ASSERT_EQ(a->min_severity(), Severity::Warning);
+    ASSERT_FALSE(a->is_enabled(Severity::Info));
+    ASSERT_TRUE(a->is_enabled(Severity::Error));
+
+    State last;
+    auto un = a->subscribe(
+        [&last](const State& state)
+        {
+            last = state;
+        });
+
+    a->log(Severity::Debug, "dropped");
+    a->log(Severity::Warning, "kept");
+    a->logf(Severity::Info, "dropped %d", 1);
+    a->logf(Severity::Error, "kept %d", 2);
+    a->flush();
+
+    ASSERT_EQ(last.size(), 2u);
+    ASSERT_EQ(last[0].message, "kept");
+    ASSERT_EQ(last[1].message, "kept 2");
+}
+
+TEST(logger_test, macros_skip_arguments_below_threshold)
+{
+    auto a = Logger::create();
+    a->set_min_severity(Severity::Info);
+
+    int evaluated = 0;
+    auto argument = [&evaluated]()
+    {
+        return ++evaluated;
+    };
+
+    MORPH_LOG_DEBUG(a, "%d", argument());
+    ASSERT_EQ(evaluated, 0);
+
+    MORPH_LOG_INFO(a, "%d", argument());
+    ASSERT_EQ(evaluated, 1);
+
+    a->flush();
+}
+
+TEST(logger_test, record_subscription_delivers_new_records)
+{
+    auto a = Logger::create();
+
+    vector<string> received;
+    auto un = a->subscribe_records(
+        [&received](const State& records)
+        {
+            for (const auto& record : records)
+            {
+                received.push_back(record.message);
+            }
+        });
+
+    for (int i = 0; i < 100; ++i)
+    {
+        a->log(Severity::Info, to_string(i));
+    }
+    a->logf(Severity::Info, "%d", 100);
+    a->flush();
+
+    ASSERT_EQ(received.size(), 101u);
+    for (size_t i = 0; i < received.size(); ++i)
+    {
+        ASSERT_EQ(received[i], to_string(i));
+    }
+
+    un.dispose();
+    un.dispose();
+
+    a->log(Severity::Info, "after dispose");
+    a->flush();
+
+    ASSERT_EQ(received.size(), 101u);
+}
+
+TEST(logger_test, record_subscription_coalesces_backlog)
+{
+    auto a = Logger::create();
+
+    promise<void> release;
+    auto released = release.get_future().share();
+
+    // Blocks the logger queue on the first record.
+    auto blocker = a->subscribe(
+        [released](const State& state)
+        {
+            if (state.size() == 1u)
+            {
+                released.wait();
+            }
+        });
+
+    vector<size_t> batches;
+    auto un = a->subscribe_records(
+        [&batches](const State& records)
+        {
+            batches.push_back(records.size());
+        });
+
+    for (int i = 0; i < 100; ++i)
+    {
+        a->log(Severity::Info, to_string(i));
+    }
+
+    release.set_value();
+    a->flush();
+
+    // At most the first record alone, then the backlog queued behind it.
+    ASSERT_LE(batches.size(), 2u);
+    ASSERT_EQ(batches.back(), batches.size() == 1u ? 100u : 99u);
+}
+
+// Emulate a build with -Dlog_level=warning,
+// the macros read MORPH_LOG_LEVEL where they are expanded.
+#undef MORPH_LOG_LEVEL
+#define MORPH_LOG_LEVEL 3
+
+TEST(logger_test, macros_compile_out_levels_below_log_level)
+{
+    auto a = Logger::create();
+
+    State last;
+    auto un = a->subscribe(
+        [&last](const State& state)
+        {
+            last = state;
+        });
+
+    int evaluated = 0;
+    auto argument = [&evaluated]()
+    {
+        return ++evaluated;
+    };
+
+    MORPH_LOG_TRACE(a, "trace %d", argument());
+    MORPH_LOG_INFO(a, "info %d", argument());
+    MORPH_LOG_WARNING(a, "warning %d", argument());
+    a->flush();
+
+    ASSERT_EQ(evaluated, 1);
+    ASSERT_EQ(last.size(), 1u);
+    ASSERT_EQ(last[0].message, "warning 1");
+}
@@ -0,0 +1,319 @@
+#include "core/binarysink.h"
+#include "core/filesink.h"
+#include "core/logger.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+using namespace testing;
+using namespace core;
+using namespace std;
+
+namespace
+{
+
+vector<string> read_lines(const string& path)
+{
+    ifstream file(path);
+    vector<string> lines;
+
+    for (string line; getline(file, line);)
+    {
+        lines.push_back(line);
+    }
+
+    return lines;
+}
+
+string temp_path(const string& name)
+{
+    const auto path = testing::TempDir() + name;
+    remove(path.c_str());
+
+    return path;
+}
+
+LogSink::Records make_records(Severity severity, const vector<string>& messages)
+{
+    LogSink::Records records;
+
+    for (const auto& message : messages)
+    {
+        LogRecord record;
+        record.severity = severity;
+        record.message = message;
+
+        records = records.push_back(std::move(record));
+    }
+
+    return records;
+}
+
+class FailingSink : public LogSink
+{
+  public:
+    void write(const Records&) override
+    {
+        throw std::runtime_error("write failed");
+    }
+
+    void flush() override
+    {
+        throw std::runtime_error("flush failed");
+    }
+};
+
+} // namespace
+
+TEST(log_sinks, file_sink)
+{
+    const auto path = temp_path("morph_file_sink.log");
+
+    {
+        auto logger = Logger::create();
+        auto sink = make_shared<FileSink>(path);
+
+        logger->add_sink(sink);
+
+        for (int i = 0; i < 3000; ++i)
+        {
+            logger->log(i % 2 ? Severity::Error : Severity::Debug, "record " + to_string(i));
+        }
+
+        logger->flush();
+
+        ASSERT_GT(sink->size(), 0u);
+    }
+
+    const auto lines = read_lines(path);
+    remove(path.c_str());
+
+    ASSERT_EQ(lines.size(), 3000u);
+    for (size_t i = 0; i < lines.size(); ++i)
+    {
+        ASSERT_THAT(lines[i], EndsWith(string(i % 2 ? " error " : " debug ") + "record " + to_string(i)));
+    }
+}
+
+TEST(log_sinks, file_sink_appends)
+{
+    const auto path = temp_path("morph_file_sink_append.log");
+
+    for (int run = 0; run < 2; ++run)
+    {
+        auto logger = Logger::create();
+        logger->add_sink(make_shared<FileSink>(path));
+        logger->log(Severity::Info, "run " + to_string(run));
+        logger->flush();
+    }
+
+    const auto lines = read_lines(path);
+    remove(path.c_str());
+
+    ASSERT_EQ(lines.size(), 2u);
+    ASSERT_THAT(lines[0], EndsWith("run 0"));
+    ASSERT_THAT(lines[1], EndsWith("run 1"));
+}
+
+TEST(log_sinks, file_sink_open_failure)
+{
+    ASSERT_THROW(FileSink("/nonexistent/directory/file.log"), std::system_error);
+}
+
+TEST(log_sinks, file_sink_buffers_records)
+{
+    const auto path = temp_path("morph_file_sink_buffer.log");
+
+    {
+        FileSink sink(path, 32u);
+
+        sink.write(make_records(Severity::Info, {"first", "second"}));
+        ASSERT_TRUE(read_lines(path).empty());
+
+        // Doesn't fit in the buffer with the previous records.
+        sink.write(make_records(Severity::Info, {"third"}));
+        ASSERT_EQ(read_lines(path).size(), 2u);
+
+        sink.flush();
+        ASSERT_EQ(read_lines(path).size(), 3u);
+
+        // Larger than the buffer.
+        sink.write(make_records(Severity::Info, {"fourth", string(100, 'x')}));
+        ASSERT_EQ(read_lines(path).size(), 5u);
+
+        sink.write(make_records(Severity::Info, {"sixth"}));
+    }
+
+    const auto lines = read_lines(path);
+    remove(path.c_str());
+
+    ASSERT_EQ(lines.size(), 6u);
+    ASSERT_THAT(lines[0], EndsWith("first"));
+    ASSERT_THAT(lines[3], EndsWith("fourth"));
+    ASSERT_THAT(lines[4], EndsWith(string(100, 'x')));
+    ASSERT_THAT(lines[5], EndsWith("sixth"));
+}
+
+TEST(log_sinks, file_sink_writes_errors_right_away)
+{
+    const auto path = temp_path("morph_file_sink_errors.log");
+
+    FileSink sink(path);
+
+    sink.write(make_records(Severity::Warning, {"warning"}));
+    ASSERT_TRUE(read_lines(path).empty());
+
+    sink.write(make_records(Severity::Error, {"error"}));
+
+    const auto lines = read_lines(path);
+    remove(path.c_str());
+
+    ASSERT_EQ(lines.size(), 2u);
+    ASSERT_THAT(lines[1], EndsWith("error"));
+}
+
+TEST(log_sinks, sink_errors_are_reported)
+{
+    auto logger = Logger::create();
+    auto sink = make_shared<FailingSink>();
+
+    vector<string> errors;
+    logger->set_sink_error_handler([&errors, &sink](LogSink& failed, const std::exception& error)
+        {
+            ASSERT_EQ(&failed, sink.get());
+            errors.push_back(error.what());
+        });
+
+    logger->add_sink(sink);
+    logger->log(Severity::Info, "record");
+    logger->flush();
+
+    ASSERT_EQ(logger->sink_errors_count(), 2u);
+    ASSERT_THAT(errors, ElementsAre("write failed", "flush failed"));
+}
+
+TEST(log_sinks, remove_sink)
+{
+    const auto path = temp_path("morph_file_sink_remove.log");
+
+    auto logger = Logger::create();
+    auto sink = make_shared<FileSink>(path);
+
+    logger->add_sink(sink);
+    logger->log(Severity::Info, "written");
+    logger->flush();
+
+    logger->remove_sink(sink);
+    logger->log(Severity::Info, "not written");
+    logger->flush();
+
+    const auto lines = read_lines(path);
+    remove(path.c_str());
+
+    ASSERT_EQ(lines.size(), 1u);
+    ASSERT_THAT(lines[0], EndsWith("written"));
+}
+
+TEST(log_sinks, rotating_file_sink)
+{
+    const auto path = temp_path("morph_rotating_sink.log");
+    for (int i = 1; i < 3; ++i)
+    {
+        remove((path + "." + to_string(i)).c_str());
+    }
+
+    {
+        auto logger = Logger::create();
+        logger->add_sink(make_shared<RotatingFileSink>(path, 100u, 3u));
+
+        // Flush after every record so that every batch holds one record.
+        for (int i = 0; i < 50; ++i)
+        {
+            logger->log(Severity::Info, "record " + to_string(i));
+            logger->flush();
+        }
+    }
+
+    const auto current = read_lines(path);
+    const auto previous = read_lines(path + ".1");
+    const auto oldest = read_lines(path + ".2");
+
+    ASSERT_TRUE(read_lines(path + ".3").empty());
+
+    ASSERT_FALSE(current.empty());
+    ASSERT_FALSE(previous.empty());
+    ASSERT_FALSE(oldest.empty());
+
+    // The files hold consecutive records, ending with the last one.
+    vector<string> lines(oldest);
+    lines.insert(lines.end(), previous.begin(), previous.end());
+    lines.insert(lines.end(), current.begin(), current.end());
+
+    const auto first = 50 - static_cast<int>(lines.size());
+    for (size_t i = 0; i < lines.size(); ++i)
+    {
+        ASSERT_THAT(lines[i], EndsWith("record " + to_string(first + static_cast<int>(i))));
+    }
+
+    for (const auto* file : {&oldest, &previous, &current})
+    {
+        ASSERT_LE(file->size(), 4u);
+    }
+
+    remove(path.c_str());
+    remove((path + ".1").c_str());
+    remove((path + ".2").c_str());
+}
+
+TEST(log_sinks, binary_sink)
+{
+    const string directory = testing::TempDir();
+
+    vector<string> segments;
+
+    {
+        auto logger = Logger::create();
+        auto sink = make_shared<BinarySink>(directory, "morph_binary_sink", 256u);
+
+        logger->add_sink(sink);
+
+        for (int i = 0; i < 100; ++i)
+        {
+            logger->log(Severity::Warning, "record " + to_string(i));
+        }
+
+        // Larger than a segment.
+        logger->log(Severity::Fatal, string(1000, 'x'));
+        logger->flush();
+
+        segments = sink->segments();
+    }
+
+    ASSERT_GT(segments.size(), 1u);
+
+    vector<LogRecord> records;
+    for (const auto& segment : segments)
+    {
+        auto segment_records = BinarySink::read_segment(segment);
+        records.insert(records.end(), segment_records.begin(), segment_records.end());
+        remove(segment.c_str());
+    }
+
+    ASSERT_EQ(records.size(), 101u);
+    for (int i = 0; i < 100; ++i)
+    {
+        ASSERT_EQ(records[i].message, "record " + to_string(i));
+        ASSERT_EQ(records[i].severity, Severity::Warning);
+    }
+
+    ASSERT_EQ(records.back().message, string(1000, 'x'));
+    ASSERT_EQ(records.back().severity, Severity::Fatal);
+}
@@ -4,8 +4,10 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
-#include <string>
+#include <array>
+#include <cstdint>
 #include <cstring>
+#include <string>
 
 using namespace foundation::immutable;
 using namespace foundation;
@@ -62,6 +64,95 @@ TEST(sharedany, shadow_equal_type)
     ASSERT_TRUE(a.template pure_is<int2>());
 }
 
+TEST(sharedany, small_values_are_inline)
+{
+    struct Color
+    {
+        float r, g, b;
+    };
+
+    static_assert(SharedAny::is_stored_inline<int8_t>);
+    static_assert(SharedAny::is_stored_inline<double>);
+    static_assert(SharedAny::is_stored_inline<Color>);
+    static_assert(!SharedAny::is_stored_inline<std::string>);
+    static_assert(!SharedAny::is_stored_inline<std::array<double, 4>>);
+
+    SharedAny a(Color {1.0f, 2.0f, 3.0f});
+
+    ASSERT_EQ(a.get<Color>()->g, 2.0f);
+    ASSERT_EQ(a.pure_cast<Color>()->b, 3.0f);
+    ASSERT_EQ(a.get<float>(), nullptr);
+}
+
+TEST(sharedany, get)
+{
+    SharedAny a(int8_t {-3});
+    SharedAny b(std::string("string"));
+    SharedAny c(std::array<double, 4> {1.0, 2.0, 3.0, 4.0});
+
+    ASSERT_EQ(*a.get<int8_t>(), -3);
+    ASSERT_EQ(a.get<int>(), nullptr);
+    ASSERT_EQ(*b.get<std::string>(), "string");
+    ASSERT_EQ((*c.get<std::array<double, 4>>())[3], 4.0);
+}
+
+TEST(sharedany, value)
+{
+    SharedAny a(int16_t {-300});
+    SharedAny b("string");
+    SharedAny c(std::string("string"));
+
+    ASSERT_EQ(a.value<int64_t>(), -300);
+    ASSERT_EQ(a.value<int>(), -300);
+    ASSERT_EQ(c.value<std::string>(), "string");
+    ASSERT_EQ(std::strcmp(c.value<const char*>(), "string"), 0);
+    ASSERT_THROW(a.value<float>(), std::bad_cast);
+    ASSERT_THROW(c.value<int>(), std::bad_cast);
+    ASSERT_EQ(std::strcmp(b.value<const char*>(), "string"), 0);
+}
+
+TEST(sharedany, int_conversions)
+{
+    SharedAny a(int8_t {-1});
+    SharedAny b(uint64_t {0x1'0000'0102});
+    SharedAny c(uint16_t {65535});
+
+    ASSERT_EQ(a.value<int64_t>(), -1);
+    ASSERT_EQ(a.value<uint8_t>(), 255);
+    ASSERT_EQ(a.value<uint32_t>(), 0xffffffffu);
+    ASSERT_EQ(b.value<uint8_t>(), 2);
+    ASSERT_EQ(b.value<int16_t>(), 258);
+    ASSERT_EQ(b.value<int64_t>(), 0x1'0000'0102);
+    ASSERT_EQ(c.value<int16_t>(), -1);
+    ASSERT_EQ(c.value<int32_t>(), 65535);
+
+    // The stored value keeps its own type.
+    ASSERT_EQ(*a.get<int8_t>(), -1);
+    ASSERT_EQ(*c.get<uint16_t>(), 65535);
+
+    SharedAny copy(a);
+    ASSERT_EQ(copy.value<int32_t>(), -1);
+}
+
+TEST(sharedany, copies_share_heap_values)
+{
+    SharedAny a(std::array<double, 4> {1.0, 2.0, 3.0, 4.0});
+    SharedAny b(0);
+
+    SharedAny copy(a);
+    b = copy;
+
+    using Array = std::array<double, 4>;
+
+    ASSERT_EQ(a.get<Array>(), b.get<Array>());
+
+    SharedAny moved(std::move(copy));
+    ASSERT_EQ(a.get<Array>(), moved.get<Array>());
+
+    moved = SharedAny(5);
+    ASSERT_EQ(moved.value<int>(), 5);
+}
+
 //
 // AnyTypeMap.
 //
@@ -127,3 +218,16 @@ TEST(any_type_map, bad_cast)
     a = a.set(0, 0);
     ASSERT_THROW(a[0]->pure_cast<bool>(), std::bad_cast);
 }
+
+TEST(any_type_map, find)
+{
+    AnyTypeMap<int> a;
+
+    a = a.set(0, 1.5f);
+    a = a.set(1, std::string("string"));
+
+    ASSERT_EQ(*a.find<float>(0), 1.5f);
+    ASSERT_EQ(*a.find<std::string>(1), "string");
+    ASSERT_EQ(a.find<int>(0), nullptr);
+    ASSERT_EQ(a.find<float>(2), nullptr);
+}
@@ -0,0 +1,149 @@
+#include "foundation/atomicsnapshot.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace foundation;
+using namespace testing;
+
+namespace
+{
+
+// Counts alive instances to catch leaks and double destruction.
+struct Tracked
+{
+    static std::atomic<int> alive;
+
+    explicit Tracked(int v = 0)
+      : value(v)
+    {
+        ++alive;
+    }
+
+    Tracked(const Tracked& other)
+      : value(other.value)
+    {
+        ++alive;
+    }
+
+    ~Tracked()
+    {
+        --alive;
+    }
+
+    int value;
+};
+
+std::atomic<int> Tracked::alive(0);
+
+} // namespace
+
+TEST(atomic_snapshot, load_store)
+{
+    AtomicSnapshot<std::string> value("a");
+
+    ASSERT_EQ(*value.load(), "a");
+
+    value.store("b");
+    ASSERT_EQ(*value.load(), "b");
+    ASSERT_EQ(value.load()->size(), 1u);
+}
+
+TEST(atomic_snapshot, snapshot_outlives_store)
+{
+    {
+        AtomicSnapshot<Tracked> value(Tracked(1));
+
+        auto snapshot = value.load();
+        value.store(Tracked(2));
+        value.store(Tracked(3));
+
+        ASSERT_EQ(snapshot->value, 1);
+        ASSERT_EQ(value.load()->value, 3);
+        ASSERT_EQ(Tracked::alive, 2);
+    }
+
+    ASSERT_EQ(Tracked::alive, 0);
+}
+
+TEST(atomic_snapshot, snapshot_outlives_container)
+{
+    {
+        auto value = std::make_unique<AtomicSnapshot<Tracked>>(Tracked(5));
+        auto snapshot = value->load();
+        value.reset();
+
+        ASSERT_EQ(snapshot->value, 5);
+    }
+
+    ASSERT_EQ(Tracked::alive, 0);
+}
+
+TEST(atomic_snapshot, many_loads_without_store)
+{
+    {
+        AtomicSnapshot<Tracked> value(Tracked(7));
+
+        // Well past the point where loads are folded into the node counter.
+        for (int i = 0; i < 200000; ++i)
+        {
+            auto snapshot = value.load();
+            ASSERT_EQ(snapshot->value, 7);
+        }
+
+        std::vector<AtomicSnapshot<Tracked>::Snapshot> held;
+        for (int i = 0; i < 100000; ++i)
+        {
+            held.push_back(value.load());
+        }
+
+        value.store(Tracked(8));
+        ASSERT_EQ(held.back()->value, 7);
+        ASSERT_EQ(Tracked::alive, 2);
+    }
+
+    ASSERT_EQ(Tracked::alive, 0);
+}
+
+TEST(atomic_snapshot, concurrent_updates)
+{
+    constexpr int threads_count = 4;
+    constexpr int updates_count = 10000;
+
+    {
+        AtomicSnapshot<Tracked> value(Tracked(0));
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < threads_count; ++t)
+        {
+            threads.emplace_back([&value]()
+                {
+                    for (int i = 0; i < updates_count; ++i)
+                    {
+                        value.update([](const Tracked& current)
+                        {
+                            return Tracked(current.value + 1);
+                        });
+
+                        auto snapshot = value.load();
+                        ASSERT_GT(snapshot->value, 0);
+                    }
+                });
+        }
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        ASSERT_EQ(value.load()->value, threads_count * updates_count);
+    }
+
+    ASSERT_EQ(Tracked::alive, 0);
+}
@@ -0,0 +1,186 @@
+#include "foundation/contentcache.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace foundation;
+using namespace testing;
+
+namespace
+{
+
+MurmurHash hash_of(int key)
+{
+    MurmurHash hash;
+    hash.append_value(key);
+
+    return hash;
+}
+
+int value_of(const ContentCache::Value& value)
+{
+    return *value.cast<int>();
+}
+
+} // namespace
+
+TEST(content_cache, counts_hits_and_misses)
+{
+    ContentCache cache(8u, 1u);
+
+    ASSERT_FALSE(cache.get(hash_of(1)).has_value());
+
+    cache.put(hash_of(1), 10);
+
+    const auto cached = cache.get(hash_of(1));
+
+    ASSERT_TRUE(cached.has_value());
+    ASSERT_EQ(value_of(*cached), 10);
+
+    const auto stats = cache.stats();
+
+    ASSERT_EQ(stats.hits, 1u);
+    ASSERT_EQ(stats.misses, 1u);
+    ASSERT_EQ(stats.evictions, 0u);
+}
+
+TEST(content_cache, evicts_least_recently_used)
+{
+    ContentCache cache(3u, 1u);
+
+    cache.put(hash_of(1), 1);
+    cache.put(hash_of(2), 2);
+    cache.put(hash_of(3), 3);
+
+    // 1 becomes the most recently used, 2 the least.
+    cache.get(hash_of(1));
+    cache.put(hash_of(4), 4);
+
+    ASSERT_EQ(cache.size(), 3u);
+    ASSERT_FALSE(cache.get(hash_of(2)).has_value());
+    ASSERT_TRUE(cache.get(hash_of(1)).has_value());
+    ASSERT_TRUE(cache.get(hash_of(3)).has_value());
+    ASSERT_TRUE(cache.get(hash_of(4)).has_value());
+    ASSERT_EQ(cache.stats().evictions, 1u);
+}
+
+TEST(content_cache, bounds_total_cost)
+{
+    ContentCache cache(10u, 1u);
+
+    cache.put(hash_of(1), 1, 4u);
+    cache.put(hash_of(2), 2, 4u);
+    cache.put(hash_of(3), 3, 4u);
+
+    ASSERT_EQ(cache.size(), 2u);
+    ASSERT_FALSE(cache.get(hash_of(1)).has_value());
+
+    // Too large to be cached at all.
+    cache.put(hash_of(4), 4, 11u);
+
+    ASSERT_FALSE(cache.get(hash_of(4)).has_value());
+    ASSERT_EQ(cache.size(), 2u);
+}
+
+TEST(content_cache, oversized_put_drops_previous_value)
+{
+    ContentCache cache(10u, 1u);
+
+    cache.put(hash_of(1), 1);
+    cache.put(hash_of(1), 2, 11u);
+
+    ASSERT_FALSE(cache.get(hash_of(1)).has_value());
+    ASSERT_EQ(cache.size(), 0u);
+}
+
+TEST(content_cache, shards_count_is_clamped_to_capacity)
+{
+    ContentCache cache(2u, 16u);
+
+    for (int i = 0; i < 32; ++i)
+    {
+        cache.put(hash_of(i), i);
+    }
+
+    ASSERT_EQ(cache.size(), 2u);
+}
+
+TEST(content_cache, shards_split_capacity_exactly)
+{
+    // 10 isn't divisible by 4, shards get 3, 3, 2 and 2.
+    ContentCache cache(10u, 4u);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        cache.put(hash_of(i), i);
+        ASSERT_LE(cache.size(), 10u);
+    }
+
+    ASSERT_EQ(cache.size(), 10u);
+}
+
+TEST(content_cache, put_replaces_value)
+{
+    ContentCache cache(2u, 1u);
+
+    cache.put(hash_of(1), 1);
+    cache.put(hash_of(1), 2);
+
+    ASSERT_EQ(cache.size(), 1u);
+    ASSERT_EQ(value_of(*cache.get(hash_of(1))), 2);
+}
+
+TEST(content_cache, get_or_compute_memoizes)
+{
+    ContentCache cache(16u);
+    int computations = 0;
+
+    const auto compute = [&computations]()
+    {
+        ++computations;
+        return std::string("result");
+    };
+
+    const auto first = cache.get_or_compute(hash_of(7), compute);
+    const auto second = cache.get_or_compute(hash_of(7), compute);
+
+    ASSERT_EQ(computations, 1);
+    ASSERT_EQ(*first.cast<std::string>(), "result");
+    ASSERT_EQ(*second.cast<std::string>(), "result");
+}
+
+TEST(content_cache, concurrent_access)
+{
+    constexpr int threads_count = 4;
+    constexpr int keys_count = 1000;
+
+    ContentCache cache(keys_count / 2);
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < threads_count; ++t)
+    {
+        threads.emplace_back([&cache]()
+        {
+            for (int i = 0; i < keys_count; ++i)
+            {
+                const auto value = cache.get_or_compute(hash_of(i), [i]() { return i; });
+                ASSERT_EQ(value_of(value), i);
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    const auto stats = cache.stats();
+
+    ASSERT_EQ(stats.hits + stats.misses, static_cast<std::uint64_t>(threads_count * keys_count));
+    ASSERT_LE(cache.size(), static_cast<std::size_t>(keys_count / 2 + 16));
+}
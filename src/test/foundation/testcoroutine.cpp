@@ -0,0 +1,140 @@
+#include "foundation/coroutine.h"
+#include "foundation/taskqueue.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace foundation;
+using namespace testing;
+
+namespace
+{
+
+Task<int> make_int(int value)
+{
+    co_return value;
+}
+
+Task<int> add(int a, int b)
+{
+    auto lhs = co_await make_int(a);
+    auto rhs = co_await make_int(b);
+
+    co_return lhs + rhs;
+}
+
+Task<> throw_error()
+{
+    throw std::runtime_error("error");
+    co_return;
+}
+
+Task<int> deep_chain(int depth)
+{
+    if (depth == 0)
+    {
+        co_return 0;
+    }
+
+    co_return (co_await deep_chain(depth - 1)) + 1;
+}
+
+} // namespace
+
+TEST(coroutine, sync_wait_value)
+{
+    ASSERT_EQ(sync_wait(make_int(42)), 42);
+}
+
+TEST(coroutine, nested_tasks)
+{
+    ASSERT_EQ(sync_wait(add(1, 2)), 3);
+}
+
+TEST(coroutine, deep_chain)
+{
+    ASSERT_EQ(sync_wait(deep_chain(1000)), 1000);
+}
+
+TEST(coroutine, exception_propagates)
+{
+    ASSERT_THROW(sync_wait(throw_error()), std::runtime_error);
+}
+
+TEST(coroutine, move_only_result)
+{
+    auto make_ptr = []() -> Task<std::unique_ptr<std::string>>
+    {
+        co_return std::make_unique<std::string>("value");
+    };
+
+    auto res = sync_wait(make_ptr());
+    ASSERT_EQ(*res, "value");
+}
+
+TEST(coroutine, schedule_resumes_on_queue)
+{
+    TaskQueue queue;
+    std::atomic<bool> posted_before(false);
+
+    queue.post([&posted_before]()
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            posted_before.store(true);
+        });
+
+    auto hop = [&]() -> Task<bool>
+    {
+        co_await queue.schedule();
+
+        // The queue is serial, so the task posted before
+        // the hop must have completed by now.
+        co_return posted_before.load();
+    };
+
+    ASSERT_TRUE(sync_wait(hop()));
+}
+
+TEST(coroutine, hop_between_queues)
+{
+    TaskQueue first;
+    TaskQueue second;
+
+    std::atomic<int> steps(0);
+
+    auto pipeline = [&]() -> Task<int>
+    {
+        co_await first.schedule();
+        steps.fetch_add(1);
+
+        co_await second.schedule();
+        steps.fetch_add(1);
+
+        co_await first.schedule();
+        co_return steps.fetch_add(1) + 1;
+    };
+
+    ASSERT_EQ(sync_wait(pipeline()), 3);
+}
+
+
+TEST(coroutine, schedule_on_shut_down_queue_throws)
+{
+    TaskQueue queue;
+    ASSERT_TRUE(queue.shutdown(std::chrono::seconds(10)));
+
+    auto hop = [&]() -> Task<int>
+    {
+        co_await queue.schedule();
+        co_return 1;
+    };
+
+    ASSERT_THROW(sync_wait(hop()), std::runtime_error);
+}
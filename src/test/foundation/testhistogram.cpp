@@ -0,0 +1,70 @@
+#include "foundation/histogram.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+using namespace foundation;
+using namespace testing;
+
+TEST(histogram, empty)
+{
+    Histogram h;
+
+    ASSERT_EQ(h.count(), 0u);
+    ASSERT_EQ(h.mean(), 0u);
+    ASSERT_EQ(h.percentile(0.5), 0u);
+}
+
+TEST(histogram, power_of_two_buckets)
+{
+    Histogram h;
+
+    h.record(0);
+    h.record(1);
+    h.record(2);
+    h.record(3);
+    h.record(1024);
+
+    ASSERT_EQ(h.count(), 5u);
+    ASSERT_EQ(h.bucket(0), 2u);
+    ASSERT_EQ(h.bucket(1), 2u);
+    ASSERT_EQ(h.bucket(10), 1u);
+    ASSERT_EQ(h.max(), 1024u);
+    ASSERT_EQ(h.mean(), 206u);
+}
+
+TEST(histogram, percentile)
+{
+    Histogram h;
+
+    for (std::uint64_t i = 0; i < 99; ++i)
+    {
+        h.record(100);
+    }
+    h.record(100000);
+
+    // 100 falls into [64, 128).
+    ASSERT_EQ(h.percentile(0.5), 127u);
+    ASSERT_EQ(h.percentile(0.98), 127u);
+    ASSERT_EQ(h.percentile(1.0), 100000u);
+}
+
+TEST(histogram, huge_values_go_to_last_bucket)
+{
+    Histogram h;
+    h.record(UINT64_MAX);
+
+    ASSERT_EQ(h.bucket(Histogram::buckets_count - 1), 1u);
+}
+
+TEST(histogram, reset)
+{
+    Histogram h;
+    h.record(42);
+    h.reset();
+
+    ASSERT_EQ(h.count(), 0u);
+    ASSERT_EQ(h.max(), 0u);
+}
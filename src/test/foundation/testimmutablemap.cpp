@@ -348,3 +348,31 @@ TEST(immutable_map, iterator_collision)
 
     ASSERT_EQ(counter, num_el);
 }
+
+TEST(immutable_map, iterator_visits_inner_node_data)
+{
+    // Small std::hash<int> values keep most elements in the root
+    // while a few of them are pushed down into children.
+    using map_t = Map<int, int>;
+    map_t m;
+
+    int expected_sum = 0;
+
+    for (int i = 0; i < 4096; i += 31)
+    {
+        m = m.set(i, i);
+        expected_sum += i;
+
+        int counter = 0;
+        int sum = 0;
+
+        for (const auto& [key, value] : m)
+        {
+            ++counter;
+            sum += value;
+        }
+
+        ASSERT_EQ(counter, static_cast<int>(m.size()));
+        ASSERT_EQ(sum, expected_sum);
+    }
+}
@@ -0,0 +1,259 @@
+#include "foundation/immutable/vector.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace foundation::immutable;
+using namespace testing;
+
+namespace
+{
+
+// Counts alive instances to catch leaks and double destruction.
+struct Tracked
+{
+    static int alive;
+
+    explicit Tracked(int v)
+      : value(v)
+    {
+        ++alive;
+    }
+
+    Tracked(const Tracked& other)
+      : value(other.value)
+    {
+        ++alive;
+    }
+
+    Tracked(Tracked&& other) noexcept
+      : value(other.value)
+    {
+        ++alive;
+    }
+
+    ~Tracked()
+    {
+        --alive;
+    }
+
+    int value;
+};
+
+int Tracked::alive = 0;
+
+} // namespace
+
+TEST(immutable_vector, empty)
+{
+    Vector<int> v;
+
+    ASSERT_TRUE(v.empty());
+    ASSERT_EQ(v.size(), 0u);
+    ASSERT_TRUE(v.begin() == v.end());
+}
+
+TEST(immutable_vector, push_back)
+{
+    Vector<int, 4> v;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        v = v.push_back(i);
+    }
+
+    ASSERT_EQ(v.size(), 100u);
+    ASSERT_EQ(v.front(), 0);
+    ASSERT_EQ(v.back(), 99);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        ASSERT_EQ(v[i], i);
+    }
+}
+
+TEST(immutable_vector, old_versions_are_unchanged)
+{
+    Vector<std::string, 4> v;
+    std::vector<Vector<std::string, 4>> versions;
+
+    for (int i = 0; i < 20; ++i)
+    {
+        versions.push_back(v);
+        v = v.push_back(std::to_string(i));
+    }
+
+    for (std::size_t i = 0; i < versions.size(); ++i)
+    {
+        ASSERT_EQ(versions[i].size(), i);
+
+        for (std::size_t j = 0; j < i; ++j)
+        {
+            ASSERT_EQ(versions[i][j], std::to_string(j));
+        }
+    }
+}
+
+TEST(immutable_vector, branching)
+{
+    Vector<int, 4> base;
+    base = base.push_back(1).push_back(2);
+
+    auto a = base.push_back(3);
+    auto b = base.push_back(4);
+    auto c = base.push_back(5).push_back(6).push_back(7);
+
+    ASSERT_EQ(base.size(), 2u);
+    ASSERT_EQ(a.size(), 3u);
+    ASSERT_EQ(b.size(), 3u);
+    ASSERT_EQ(c.size(), 5u);
+
+    ASSERT_EQ(a[2], 3);
+    ASSERT_EQ(b[2], 4);
+    ASSERT_EQ(c[2], 5);
+    ASSERT_EQ(c[4], 7);
+
+    ASSERT_EQ(b[0], 1);
+    ASSERT_EQ(c[1], 2);
+}
+
+TEST(immutable_vector, iteration)
+{
+    Vector<int, 3> v;
+    for (int i = 0; i < 10; ++i)
+    {
+        v = v.push_back(i);
+    }
+
+    int expected = 0;
+    for (const auto& i : v)
+    {
+        ASSERT_EQ(i, expected++);
+    }
+
+    ASSERT_EQ(expected, 10);
+}
+
+TEST(immutable_vector, drop_front)
+{
+    Vector<int, 4> v;
+    for (int i = 0; i < 50; ++i)
+    {
+        v = v.push_back(i);
+    }
+
+    auto dropped = v.drop_front(45);
+
+    ASSERT_EQ(v.size(), 50u);
+    ASSERT_EQ(dropped.size(), 5u);
+
+    for (int i = 0; i < 5; ++i)
+    {
+        ASSERT_EQ(dropped[i], 45 + i);
+    }
+
+    dropped = dropped.push_back(50);
+    ASSERT_EQ(dropped.back(), 50);
+    ASSERT_EQ(v.back(), 49);
+
+    ASSERT_TRUE(v.drop_front(100).empty());
+}
+
+TEST(immutable_vector, sliding_window)
+{
+    Vector<int, 4> v;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        v = v.push_back(i);
+
+        if (v.size() > 10u)
+        {
+            v = v.drop_front(v.size() - 10u);
+        }
+    }
+
+    ASSERT_EQ(v.size(), 10u);
+    for (int i = 0; i < 10; ++i)
+    {
+        ASSERT_EQ(v[i], 990 + i);
+    }
+}
+
+TEST(immutable_vector, elements_are_destroyed)
+{
+    {
+        Vector<Tracked, 4> v;
+        auto branch = v;
+
+        for (int i = 0; i < 30; ++i)
+        {
+            v = v.push_back(Tracked(i));
+
+            if (i == 10)
+            {
+                branch = v.push_back(Tracked(-1));
+            }
+        }
+
+        v = v.drop_front(25);
+
+        ASSERT_EQ(branch[11].value, -1);
+        ASSERT_EQ(v[0].value, 25);
+    }
+
+    ASSERT_EQ(Tracked::alive, 0);
+}
+
+TEST(immutable_vector, concurrent_branching)
+{
+    Vector<int, 8> base;
+    for (int i = 0; i < 5; ++i)
+    {
+        base = base.push_back(i);
+    }
+
+    constexpr int nthreads = 8;
+    std::vector<Vector<int, 8>> results(nthreads);
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < nthreads; ++t)
+    {
+        threads.emplace_back([&base, &results, t]()
+            {
+                auto v = base;
+                for (int i = 0; i < 100; ++i)
+                {
+                    v = v.push_back(t * 1000 + i);
+                }
+                results[t] = v;
+            });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (int t = 0; t < nthreads; ++t)
+    {
+        const auto& v = results[t];
+        ASSERT_EQ(v.size(), 105u);
+
+        for (int i = 0; i < 5; ++i)
+        {
+            ASSERT_EQ(v[i], i);
+        }
+
+        for (int i = 0; i < 100; ++i)
+        {
+            ASSERT_EQ(v[5 + i], t * 1000 + i);
+        }
+    }
+}
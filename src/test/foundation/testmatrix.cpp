@@ -0,0 +1,237 @@
+#include "foundation/matrix.h"
+#include "foundation/vectorstream.h"
+
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace foundation;
+
+namespace
+{
+
+const Matrix4f affine({
+    0.0f, -2.0f, 0.0f, 1.0f,
+    1.0f,  0.0f, 0.0f, 2.0f,
+    0.0f,  0.0f, 3.0f, 3.0f,
+    0.0f,  0.0f, 0.0f, 1.0f});
+
+const Matrix4f general({
+    2.0f, 1.0f, 0.0f, 3.0f,
+    0.0f, 1.0f, 4.0f, 1.0f,
+    5.0f, 0.0f, 1.0f, 0.0f,
+    1.0f, 2.0f, 0.0f, 1.0f});
+
+const Matrix3f general3({
+    2.0f, -1.0f, 0.5f,
+    0.0f,  3.0f, 4.0f,
+    5.0f,  1.0f, 1.0f});
+
+template <std::size_t Size>
+void expect_near(const Matrix<Size, float>& expected, const Matrix<Size, float>& actual)
+{
+    for (std::size_t i = 0; i < Size * Size; ++i)
+    {
+        EXPECT_NEAR(expected.data()[i], actual.data()[i], 1e-5f);
+    }
+}
+
+std::vector<Vector3f> make_points(std::size_t count)
+{
+    std::vector<Vector3f> result;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const auto f = static_cast<float>(i);
+        result.emplace_back(f, 2.0f * f - 1.0f, 3.0f - f);
+    }
+
+    return result;
+}
+
+} // namespace
+
+TEST(matrix, identity)
+{
+    const Vector4f v(1.0f, 2.0f, 3.0f, 4.0f);
+
+    ASSERT_EQ(general, Matrix4f::identity() * general);
+    ASSERT_EQ(general, general * Matrix4f::identity());
+    ASSERT_EQ(v, Matrix4f::identity() * v);
+}
+
+TEST(matrix, mult)
+{
+    const Matrix3f a({
+        1.0f, 2.0f, 3.0f,
+        4.0f, 5.0f, 6.0f,
+        7.0f, 8.0f, 9.0f});
+
+    const Matrix3f b({
+        0.0f, 1.0f, 0.0f,
+        1.0f, 0.0f, 0.0f,
+        0.0f, 0.0f, 2.0f});
+
+    const Matrix3f res({
+        2.0f, 1.0f,  6.0f,
+        5.0f, 4.0f, 12.0f,
+        8.0f, 7.0f, 18.0f});
+
+    ASSERT_EQ(res, a * b);
+    ASSERT_EQ(Vector3f(8.0f, 20.0f, 32.0f), a * Vector3f(2.0f, 0.0f, 2.0f));
+}
+
+TEST(matrix, mult_is_composition)
+{
+    const Vector4f v(1.0f, -2.0f, 0.5f, 1.0f);
+
+    const auto lhs = (general * affine) * v;
+    const auto rhs = general * (affine * v);
+
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        ASSERT_FLOAT_EQ(rhs[i], lhs[i]);
+    }
+}
+
+TEST(matrix, transpose)
+{
+    const auto t = transpose(general);
+
+    ASSERT_EQ(general(0, 3), t(3, 0));
+    ASSERT_EQ(general(2, 1), t(1, 2));
+    ASSERT_EQ(general, transpose(t));
+}
+
+TEST(matrix, determinant)
+{
+    ASSERT_FLOAT_EQ(6.0f, determinant(affine));
+    ASSERT_FLOAT_EQ(1.0f, determinant(Matrix4f::identity()));
+    ASSERT_FLOAT_EQ(0.0f, determinant(Matrix3f()));
+}
+
+TEST(matrix, inverse)
+{
+    expect_near(Matrix4f::identity(), inverse(general) * general);
+    expect_near(Matrix4f::identity(), affine * inverse(affine));
+    expect_near(Matrix3f::identity(), inverse(Matrix3f({2.0f, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f, 1.0f}))
+        * Matrix3f({2.0f, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f, 1.0f}));
+}
+
+TEST(matrix, inverse_of_singular_matrix_throws)
+{
+    Matrix4f singular = general;
+    singular(3, 0) = singular(0, 0);
+    singular(3, 1) = singular(0, 1);
+    singular(3, 2) = singular(0, 2);
+    singular(3, 3) = singular(0, 3);
+
+    ASSERT_THROW(inverse(singular), std::domain_error);
+    ASSERT_THROW((inverse<4, float>(singular)), std::domain_error);
+}
+
+TEST(matrix, inverse_of_singular_matrix3_throws)
+{
+    Matrix3f singular = general3;
+    singular(2, 0) = 2.0f * singular(0, 0);
+    singular(2, 1) = 2.0f * singular(0, 1);
+    singular(2, 2) = 2.0f * singular(0, 2);
+
+    ASSERT_THROW(inverse(singular), std::domain_error);
+    ASSERT_THROW((inverse<3, float>(singular)), std::domain_error);
+}
+
+TEST(matrix, transform_point_and_direction)
+{
+    const Vector3f p(1.0f, 2.0f, 3.0f);
+
+    ASSERT_EQ(Vector3f(-3.0f, 3.0f, 12.0f), transform_point(affine, p));
+    ASSERT_EQ(Vector3f(-4.0f, 1.0f, 9.0f), transform_direction(affine, p));
+}
+
+TEST(matrix, make_affine)
+{
+    const Matrix3f linear({
+        0.0f, -2.0f, 0.0f,
+        1.0f,  0.0f, 0.0f,
+        0.0f,  0.0f, 3.0f});
+
+    ASSERT_EQ(affine, make_affine(linear, Vector3f(1.0f, 2.0f, 3.0f)));
+}
+
+TEST(matrix, transform_points)
+{
+    // Not a multiple of four, so both the SIMD and the scalar paths run.
+    const auto points = make_points(11);
+
+    std::vector<Vector3f> out;
+    transform_points(general, points, out);
+
+    VectorStream3f stream(points);
+    transform_points(general, stream, stream);
+
+    ASSERT_EQ(points.size(), out.size());
+
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        const auto expected = transform_point(general, points[i]);
+
+        ASSERT_EQ(expected, out[i]);
+        ASSERT_EQ(expected, stream.get(i));
+    }
+}
+
+TEST(matrix, transform_points_in_place)
+{
+    auto points = make_points(9);
+    const auto expected = points;
+
+    transform_points(affine, points, points);
+    transform_points(inverse(affine), points, points);
+
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        for (std::size_t d = 0; d < 3; ++d)
+        {
+            ASSERT_NEAR(expected[i][d], points[i][d], 1e-5f);
+        }
+    }
+}
+
+TEST(matrix, matches_generic_implementation)
+{
+    const Vector4f v(1.0f, -2.0f, 0.5f, 1.0f);
+
+    ASSERT_EQ((operator*<4, float>(general, affine)), general * affine);
+    ASSERT_EQ((operator*<4, float>(general, v)), general * v);
+    expect_near(inverse<4, float>(general), inverse(general));
+
+    const auto points = make_points(7);
+
+    std::vector<Vector3f> generic;
+    transform_points<float>(general, points, generic);
+
+    std::vector<Vector3f> specialized;
+    transform_points(general, points, specialized);
+
+    ASSERT_EQ(generic, specialized);
+}
+
+TEST(matrix, matrix3_matches_generic_implementation)
+{
+    const Matrix3f other({
+        1.0f, 0.0f, -2.0f,
+        0.5f, 2.0f,  1.0f,
+        3.0f, 1.0f,  0.0f});
+
+    const Vector3f v(1.0f, -2.0f, 0.5f);
+
+    ASSERT_EQ((operator*<3, float>(general3, other)), general3 * other);
+    ASSERT_EQ((operator*<3, float>(general3, v)), general3 * v);
+    expect_near(inverse<3, float>(general3), inverse(general3));
+    expect_near(Matrix3f::identity(), general3 * inverse(general3));
+}
@@ -0,0 +1,209 @@
+#include "foundation/immutable/map.h"
+#include "foundation/murmurhash.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using namespace foundation;
+using namespace testing;
+
+namespace
+{
+
+struct Point
+{
+    int x;
+    int y;
+
+    MurmurHash hash() const noexcept
+    {
+        MurmurHash result;
+        result.append(this, sizeof(*this));
+        return result;
+    }
+
+    bool operator==(const Point& other) const noexcept
+    {
+        return x == other.x && y == other.y;
+    }
+};
+
+enum class Color : std::uint8_t
+{
+    Red,
+    Green
+};
+
+MurmurHash hash_of(std::string_view bytes)
+{
+    MurmurHash hash;
+    hash.append(bytes.data(), bytes.size());
+
+    return hash;
+}
+
+} // namespace
+
+TEST(murmur_hash, matches_reference)
+{
+    using Hash128 = std::pair<std::uint64_t, std::uint64_t>;
+
+    ASSERT_EQ(hash_of("").as_128bit(), Hash128(0u, 0u));
+    ASSERT_EQ(
+        hash_of("hello").as_128bit(),
+        Hash128(0xcbd8a7b341bd9b02u, 0x5b1e906a48ae1d19u));
+    ASSERT_EQ(
+        hash_of("The quick brown fox jumps over the lazy dog").as_128bit(),
+        Hash128(0xe34bbc7bbc071b6cu, 0x7a433ca9c49a9347u));
+}
+
+TEST(murmur_hash, streaming_matches_one_shot)
+{
+    const std::string_view message = "The quick brown fox jumps over the lazy dog";
+    const auto expected = hash_of(message).as_128bit();
+
+    for (std::size_t i = 0; i <= message.size(); ++i)
+    {
+        for (std::size_t j = i; j <= message.size(); ++j)
+        {
+            MurmurHash hash;
+
+            hash.append(message.data(), i);
+            hash.append(message.data() + i, j - i);
+            hash.append(message.data() + j, message.size() - j);
+
+            ASSERT_EQ(hash.as_128bit(), expected);
+        }
+    }
+}
+
+TEST(murmur_hash, append_value_matches_bytes)
+{
+    const std::uint32_t a = 0x01020304u;
+    const std::uint64_t b = 0x05060708090a0b0cu;
+    const std::uint16_t c = 0x0d0eu;
+
+    MurmurHash fields;
+
+    for (int i = 0; i < 5; ++i)
+    {
+        fields.append_value(a);
+        fields.append_value(b);
+        fields.append_value(c);
+    }
+
+    std::string bytes;
+
+    for (int i = 0; i < 5; ++i)
+    {
+        bytes.append(reinterpret_cast<const char*>(&a), sizeof(a));
+        bytes.append(reinterpret_cast<const char*>(&b), sizeof(b));
+        bytes.append(reinterpret_cast<const char*>(&c), sizeof(c));
+    }
+
+    ASSERT_EQ(fields.as_128bit(), hash_of(bytes).as_128bit());
+}
+
+TEST(murmur_hash, batch_matches_scalar)
+{
+    const std::string text =
+        "Bulk map construction and content addressed caching hash "
+        "millions of keys per second.";
+
+    // Runs of equal sizes, hashed in parallel, and of mixed sizes.
+    std::vector<std::string_view> inputs;
+
+    for (std::size_t size = 0; size <= 40; ++size)
+    {
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            inputs.push_back(std::string_view(text).substr(i, size));
+        }
+
+        inputs.push_back(std::string_view(text).substr(0, size / 2));
+    }
+
+    std::vector<std::size_t> hashes(inputs.size());
+    murmur_hash_batch(inputs.data(), inputs.size(), hashes.data());
+
+    for (std::size_t i = 0; i < inputs.size(); ++i)
+    {
+        ASSERT_EQ(hashes[i], hash_of(inputs[i]).as_64bit()) << "input " << i;
+    }
+}
+
+TEST(default_hasher, spreads_sequential_ids)
+{
+    // The first level of a HAMT consumes the low 6 bits.
+    constexpr std::size_t buckets = 64;
+    constexpr std::size_t ids = buckets * 256;
+
+    std::array<std::size_t, buckets> counts {};
+
+    for (std::uint64_t id = 0; id < ids; ++id)
+    {
+        ++counts[DefaultHasher<std::uint64_t> {}(id) % buckets];
+    }
+
+    for (const auto count : counts)
+    {
+        ASSERT_GT(count, ids / buckets / 2);
+        ASSERT_LT(count, ids / buckets * 2);
+    }
+}
+
+TEST(default_hasher, integers_use_std_hash)
+{
+    for (std::uint64_t id : {0ull, 1ull, 4096ull, 1ull << 40})
+    {
+        ASSERT_EQ(DefaultHasher<std::uint64_t> {}(id), std::hash<std::uint64_t> {}(id));
+    }
+
+    int value = 0;
+    ASSERT_NE(DefaultHasher<int*> {}(&value), std::hash<int*> {}(&value));
+}
+
+TEST(default_hasher, strings_hash_their_bytes)
+{
+    const std::string s = "morph";
+
+    ASSERT_EQ(DefaultHasher<std::string> {}(s), DefaultHasher<std::string_view> {}("morph"));
+    ASSERT_NE(DefaultHasher<std::string> {}(s), DefaultHasher<std::string> {}("morpH"));
+}
+
+TEST(default_hasher, uses_murmur_hash_of_class)
+{
+    const Point p {1, 2};
+
+    ASSERT_EQ(DefaultHasher<Point> {}(p), Hasher<Point> {}(p));
+    ASSERT_EQ(DefaultHasher<Color> {}(Color::Green), DefaultHasher<std::uint8_t> {}(1u));
+}
+
+TEST(default_hasher, map_with_default_hash)
+{
+    immutable::Map<Point, int> points;
+    immutable::Map<std::string, int> names;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        points = points.set(Point {i, -i}, i);
+        names = names.set(std::to_string(i), i);
+    }
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        ASSERT_EQ(*points.get(Point {i, -i}), i);
+        ASSERT_EQ(*names.get(std::to_string(i)), i);
+    }
+
+    ASSERT_EQ(points.get(Point {1, 1}), nullptr);
+}
@@ -1,6 +1,12 @@
 #include "foundation/observable.h"
+#include "foundation/taskqueue.h"
 
+#include <atomic>
+#include <chrono>
+#include <future>
 #include <thread>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 #include <gmock/gmock.h>
@@ -27,6 +33,37 @@ class AObs : public Observable<State>
     State m_state;
 };
 
+namespace
+{
+
+// Counts the copies and moves that led to a value.
+struct Tracked
+{
+    Tracked() = default;
+
+    Tracked(const Tracked& other) noexcept
+      : copies(other.copies + 1)
+      , moves(other.moves)
+    {}
+
+    Tracked(Tracked&& other) noexcept
+      : copies(other.copies)
+      , moves(other.moves + 1)
+    {}
+
+    int copies = 0;
+    int moves = 0;
+};
+
+template <typename... Args>
+class Notifier : public Observable<Args...>
+{
+  public:
+    using Observable<Args...>::notify;
+};
+
+} // namespace
+
 TEST(observable_test, observable_simple_working)
 {
     int b = 0;
@@ -88,3 +125,256 @@ TEST(observable_test, unsubscribe_after_delete_observable)
     un_1.dispose();
     un_1.dispose();
 }
+
+TEST(observable_test, delivers_in_subscription_order)
+{
+    auto a = make_shared<AObs>();
+    vector<int> order;
+    vector<AObs::Disposable> subscriptions;
+
+    // More subscribers than are stored inline.
+    for (int i = 0; i < 10; ++i)
+    {
+        subscriptions.push_back(a->subscribe([&order, i](const auto&)
+        {
+            order.push_back(i);
+        }));
+    }
+
+    subscriptions[3].dispose();
+    subscriptions[7].dispose();
+
+    a->add(0);
+
+    ASSERT_THAT(order, ElementsAre(0, 1, 2, 4, 5, 6, 8, 9));
+}
+
+TEST(observable_test, coalescing_collapses_to_latest_state)
+{
+    TaskQueue queue;
+    auto a = make_shared<AObs>();
+    a->enable_coalescing(queue);
+
+    vector<State> delivered;
+    a->subscribe([&delivered](const auto& state)
+    {
+        delivered.push_back(state);
+    });
+
+    // Keep the queue busy while the burst is issued.
+    promise<void> release;
+    queue.post([released = release.get_future().share()]() { released.wait(); });
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        a->add(i);
+    }
+
+    ASSERT_TRUE(delivered.empty());
+
+    release.set_value();
+    queue.drain();
+
+    ASSERT_EQ(delivered.size(), 1u);
+    ASSERT_EQ(delivered[0].size(), 1000u);
+    ASSERT_EQ(delivered[0].back(), 999);
+}
+
+TEST(observable_test, coalescing_max_latency)
+{
+    TaskQueue queue;
+    auto a = make_shared<AObs>();
+    a->enable_coalescing(queue, 50ms);
+
+    atomic<int> deliveries(0);
+    atomic<size_t> last_size(0);
+    a->subscribe([&deliveries, &last_size](const auto& state)
+    {
+        ++deliveries;
+        last_size = state.size();
+    });
+
+    for (int i = 0; i < 100; ++i)
+    {
+        a->add(i);
+    }
+
+    std::this_thread::sleep_for(150ms);
+    queue.drain();
+
+    ASSERT_EQ(deliveries, 1);
+    ASSERT_EQ(last_size, 100u);
+
+    a->add(100);
+    std::this_thread::sleep_for(150ms);
+    queue.drain();
+
+    ASSERT_EQ(deliveries, 2);
+    ASSERT_EQ(last_size, 101u);
+}
+
+TEST(observable_test, disable_coalescing)
+{
+    TaskQueue queue;
+    auto a = make_shared<AObs>();
+
+    int deliveries = 0;
+    a->subscribe([&deliveries](const auto&)
+    {
+        ++deliveries;
+    });
+
+    a->enable_coalescing(queue);
+    a->disable_coalescing();
+
+    a->add(0);
+    a->add(1);
+
+    ASSERT_EQ(deliveries, 2);
+}
+
+TEST(observable_test, coalescing_skips_destroyed_observable)
+{
+    TaskQueue queue;
+    atomic<int> deliveries(0);
+
+    promise<void> release;
+    queue.post([released = release.get_future().share()]() { released.wait(); });
+
+    {
+        auto a = make_shared<AObs>();
+        a->enable_coalescing(queue);
+        a->subscribe([&deliveries](const auto&)
+        {
+            ++deliveries;
+        });
+
+        a->add(0);
+    }
+
+    release.set_value();
+    queue.drain();
+
+    ASSERT_EQ(deliveries, 0);
+}
+
+TEST(observable_test, coalescing_after_queue_shutdown)
+{
+    TaskQueue queue;
+    auto a = make_shared<AObs>();
+    a->enable_coalescing(queue);
+
+    vector<size_t> delivered;
+    a->subscribe([&delivered](const auto& state)
+    {
+        delivered.push_back(state.size());
+    });
+
+    ASSERT_TRUE(queue.shutdown(10s));
+
+    a->add(0);
+    a->add(1);
+
+    ASSERT_THAT(delivered, ElementsAre(1u, 2u));
+}
+
+TEST(observable_test, coalescing_recovers_from_dropped_delivery)
+{
+    TaskQueue queue;
+    auto a = make_shared<AObs>();
+    a->enable_coalescing(queue, 50ms);
+
+    vector<size_t> delivered;
+    a->subscribe([&delivered](const auto& state)
+    {
+        delivered.push_back(state.size());
+    });
+
+    // The delivery comes due after the shutdown and is dropped.
+    a->add(0);
+    ASSERT_TRUE(queue.shutdown(10s));
+    std::this_thread::sleep_for(150ms);
+
+    ASSERT_TRUE(delivered.empty());
+
+    a->add(1);
+
+    ASSERT_THAT(delivered, ElementsAre(2u));
+}
+
+TEST(observable_test, notify_passes_arguments_by_reference)
+{
+    auto a = make_shared<Notifier<Tracked>>();
+
+    vector<const Tracked*> addresses;
+    vector<Tracked> delivered;
+    delivered.reserve(2u);
+    a->subscribe([&](const Tracked& value)
+    {
+        addresses.push_back(&value);
+        delivered.push_back(value);
+    });
+
+    const Tracked value;
+    a->notify(value);
+    a->notify(Tracked());
+
+    ASSERT_EQ(addresses.size(), 2u);
+    ASSERT_EQ(addresses[0], &value);
+
+    // Every delivered value was copied once, by the subscriber.
+    for (const auto& d : delivered)
+    {
+        ASSERT_EQ(d.copies, 1);
+        ASSERT_EQ(d.moves, 0);
+    }
+}
+
+TEST(observable_test, coalescing_moves_rvalue_arguments)
+{
+    TaskQueue queue;
+    auto a = make_shared<Notifier<Tracked>>();
+    a->enable_coalescing(queue);
+
+    vector<pair<int, int>> delivered;
+    a->subscribe([&delivered](const Tracked& value)
+    {
+        delivered.emplace_back(value.copies, value.moves);
+    });
+
+    a->notify(Tracked());
+    queue.drain();
+
+    const Tracked value;
+    a->notify(value);
+    queue.drain();
+
+    // Moved in and out of the pending notification, copied only
+    // when notified with an lvalue.
+    ASSERT_THAT(delivered, ElementsAre(Pair(0, Gt(0)), Pair(1, Gt(0))));
+}
+
+TEST(observable_test, notify_without_arguments_and_with_references)
+{
+    auto empty = make_shared<Notifier<>>();
+    auto reference = make_shared<Notifier<int&>>();
+
+    int notified = 0;
+    empty->subscribe([&notified]() { ++notified; });
+
+    int value = 1;
+    reference->subscribe([&value, &notified](const int& v)
+    {
+        ASSERT_EQ(&v, &value);
+        ++notified;
+    });
+
+    empty->notify();
+    reference->notify(value);
+
+    // A temporary can't be notified to subscribers taking a reference.
+    static_assert(!detail::are_notify_arguments<tuple<int&>, tuple<int>>::value);
+    static_assert(detail::are_notify_arguments<tuple<int&>, tuple<int&>>::value);
+
+    ASSERT_EQ(notified, 2);
+}
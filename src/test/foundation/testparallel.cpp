@@ -0,0 +1,147 @@
+#include "foundation/parallel.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <vector>
+
+using namespace foundation;
+using namespace testing;
+
+TEST(parallel, parallel_for_visits_every_index_once)
+{
+    constexpr std::size_t n = 100000;
+    std::vector<std::atomic<int>> visits(n);
+
+    for (auto& v : visits)
+    {
+        v.store(0);
+    }
+
+    parallel_for(std::size_t(0), n, [&visits](std::size_t i) { visits[i].fetch_add(1); });
+
+    for (const auto& v : visits)
+    {
+        ASSERT_EQ(v.load(), 1);
+    }
+}
+
+TEST(parallel, parallel_for_with_grain_size)
+{
+    constexpr int n = 1000;
+    std::vector<int> values(n, 0);
+
+    parallel_for(0, n, [&values](int i) { values[i] = i * 2; }, 16u);
+
+    for (int i = 0; i < n; ++i)
+    {
+        ASSERT_EQ(values[i], i * 2);
+    }
+}
+
+TEST(parallel, parallel_for_empty_range)
+{
+    bool called = false;
+    parallel_for(10, 10, [&called](int) { called = true; });
+    parallel_for(10, 5, [&called](int) { called = true; });
+
+    ASSERT_FALSE(called);
+}
+
+TEST(parallel, parallel_reduce_sum)
+{
+    constexpr std::uint64_t n = 1000000;
+
+    auto sum = parallel_reduce(
+        std::uint64_t(0),
+        n,
+        std::uint64_t(0),
+        [](std::uint64_t b, std::uint64_t e, std::uint64_t acc)
+        {
+            for (auto i = b; i != e; ++i)
+            {
+                acc += i;
+            }
+            return acc;
+        },
+        std::plus<std::uint64_t>());
+
+    ASSERT_EQ(sum, n * (n - 1) / 2);
+}
+
+TEST(parallel, parallel_reduce_deterministic)
+{
+    constexpr std::size_t n = 1 << 20;
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+    std::vector<float> values(n);
+    for (auto& v : values)
+    {
+        v = dist(rng);
+    }
+
+    auto sum = [&values]()
+    {
+        return parallel_reduce(
+            std::size_t(0),
+            values.size(),
+            0.0f,
+            [&values](std::size_t b, std::size_t e, float acc)
+            {
+                for (auto i = b; i != e; ++i)
+                {
+                    acc += values[i];
+                }
+                return acc;
+            },
+            std::plus<float>(),
+            0u,
+            ReductionOrder::Deterministic);
+    };
+
+    const auto expected = sum();
+    for (int i = 0; i < 10; ++i)
+    {
+        ASSERT_EQ(sum(), expected);
+    }
+}
+
+TEST(parallel, parallel_reduce_empty_range)
+{
+    auto res = parallel_reduce(
+        0,
+        0,
+        42,
+        [](int, int, int acc) { return acc + 1; },
+        std::plus<int>());
+
+    ASSERT_EQ(res, 42);
+}
+
+TEST(parallel, parallel_sort)
+{
+    std::mt19937 rng(3);
+    std::vector<int> values(100000);
+
+    for (auto& v : values)
+    {
+        v = static_cast<int>(rng());
+    }
+
+    auto expected = values;
+    std::sort(expected.begin(), expected.end(), std::greater<int>());
+
+    parallel_sort(values.begin(), values.end(), std::greater<int>());
+    ASSERT_EQ(values, expected);
+
+    parallel_sort(values.begin(), values.end());
+    ASSERT_TRUE(std::is_sorted(values.begin(), values.end()));
+}
@@ -0,0 +1,96 @@
+#include "foundation/matrix.h"
+#include "foundation/quaternion.h"
+
+#include <cmath>
+#include <cstddef>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace foundation;
+
+namespace
+{
+
+constexpr float half_pi = 1.57079632679f;
+
+void expect_near(const Vector3f& expected, const Vector3f& actual)
+{
+    EXPECT_NEAR(expected.x(), actual.x(), 1e-5f);
+    EXPECT_NEAR(expected.y(), actual.y(), 1e-5f);
+    EXPECT_NEAR(expected.z(), actual.z(), 1e-5f);
+}
+
+} // namespace
+
+TEST(quaternion, identity)
+{
+    const Quaternionf q(1.0f, 2.0f, 3.0f, 4.0f);
+    const Vector3f v(1.0f, 2.0f, 3.0f);
+
+    ASSERT_EQ(q, Quaternionf::identity() * q);
+    ASSERT_EQ(q, q * Quaternionf::identity());
+    ASSERT_EQ(v, rotate(Quaternionf::identity(), v));
+}
+
+TEST(quaternion, mult)
+{
+    const Quaternionf i(1.0f, 0.0f, 0.0f, 0.0f);
+    const Quaternionf j(0.0f, 1.0f, 0.0f, 0.0f);
+    const Quaternionf k(0.0f, 0.0f, 1.0f, 0.0f);
+
+    ASSERT_EQ(k, i * j);
+    ASSERT_EQ(i, j * k);
+    ASSERT_EQ(j, k * i);
+    ASSERT_EQ(Quaternionf(0.0f, 0.0f, 0.0f, -1.0f), i * i);
+}
+
+TEST(quaternion, rotate)
+{
+    const auto q = Quaternionf::from_axis_angle(Vector3f(0.0f, 0.0f, 1.0f), half_pi);
+
+    expect_near(Vector3f(0.0f, 1.0f, 0.0f), rotate(q, Vector3f(1.0f, 0.0f, 0.0f)));
+    expect_near(Vector3f(-1.0f, 0.0f, 2.0f), rotate(q, Vector3f(0.0f, 1.0f, 2.0f)));
+}
+
+TEST(quaternion, mult_composes_rotations)
+{
+    const auto a = Quaternionf::from_axis_angle(Vector3f(0.0f, 0.0f, 1.0f), half_pi);
+    const auto b = Quaternionf::from_axis_angle(Vector3f(1.0f, 0.0f, 0.0f), half_pi);
+    const Vector3f v(1.0f, 2.0f, 3.0f);
+
+    expect_near(rotate(a, rotate(b, v)), rotate(a * b, v));
+}
+
+TEST(quaternion, conjugate_inverts_rotation)
+{
+    const auto q = normalize(Quaternionf(0.3f, -0.2f, 0.9f, 0.5f));
+    const Vector3f v(1.0f, 2.0f, 3.0f);
+
+    ASSERT_NEAR(1.0f, dot_product(q, q), 1e-6f);
+    expect_near(v, rotate(conjugate(q), rotate(q, v)));
+}
+
+TEST(quaternion, to_matrix)
+{
+    const auto q = normalize(Quaternionf(0.3f, -0.2f, 0.9f, 0.5f));
+    const Vector3f v(1.0f, 2.0f, 3.0f);
+
+    expect_near(rotate(q, v), to_matrix(q) * v);
+}
+
+TEST(quaternion, matches_generic_implementation)
+{
+    const Quaternionf a(0.3f, -0.2f, 0.9f, 0.5f);
+    const Quaternionf b(-1.0f, 2.0f, 0.5f, 3.0f);
+
+    const auto generic = operator*<float>(a, b);
+    const auto specialized = a * b;
+
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        ASSERT_FLOAT_EQ(generic[i], specialized[i]);
+    }
+
+    ASSERT_FLOAT_EQ(dot_product<float>(a, b), dot_product(a, b));
+}
@@ -0,0 +1,96 @@
+#include "foundation/spscqueue.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+using namespace foundation;
+using namespace testing;
+
+TEST(spsc_queue, capacity_is_rounded_up)
+{
+    SpscQueue<int> queue(100);
+
+    ASSERT_EQ(queue.capacity(), 128u);
+}
+
+TEST(spsc_queue, push_pop)
+{
+    SpscQueue<int> queue(4);
+    int value = 0;
+
+    ASSERT_TRUE(queue.empty());
+    ASSERT_FALSE(queue.try_pop(value));
+
+    for (int i = 0; i < 4; ++i)
+    {
+        ASSERT_TRUE(queue.try_push(i));
+    }
+
+    // Full.
+    ASSERT_FALSE(queue.try_push(4));
+
+    for (int i = 0; i < 4; ++i)
+    {
+        ASSERT_TRUE(queue.try_pop(value));
+        ASSERT_EQ(value, i);
+    }
+
+    ASSERT_TRUE(queue.empty());
+    ASSERT_FALSE(queue.try_pop(value));
+}
+
+TEST(spsc_queue, wraps_around)
+{
+    SpscQueue<int> queue(4);
+    int value = 0;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        ASSERT_TRUE(queue.try_push(i));
+        ASSERT_TRUE(queue.try_push(i + 1000));
+        ASSERT_TRUE(queue.try_pop(value));
+        ASSERT_EQ(value, i);
+        ASSERT_TRUE(queue.try_pop(value));
+        ASSERT_EQ(value, i + 1000);
+    }
+}
+
+TEST(spsc_queue, producer_consumer_threads)
+{
+    constexpr std::uint64_t count = 1000000;
+    SpscQueue<std::uint64_t> queue(64);
+
+    std::thread producer([&queue]()
+        {
+            for (std::uint64_t i = 0; i < count; ++i)
+            {
+                while (!queue.try_push(i))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+    std::uint64_t expected = 0;
+    std::uint64_t value = 0;
+
+    while (expected < count)
+    {
+        if (queue.try_pop(value))
+        {
+            ASSERT_EQ(value, expected);
+            ++expected;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    producer.join();
+    ASSERT_TRUE(queue.empty());
+}
@@ -0,0 +1,119 @@
+#include "foundation/subscriberlist.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace foundation;
+using namespace testing;
+
+using List = SubscriberList<int, int, 2>;
+
+namespace
+{
+
+std::vector<int> keys(const List& list)
+{
+    std::vector<int> result;
+
+    for (const auto& [key, value] : list)
+    {
+        result.push_back(key);
+    }
+
+    return result;
+}
+
+} // namespace
+
+TEST(subscriber_list, insert_keeps_key_order)
+{
+    List list;
+
+    list = list.insert(1, 10);
+    list = list.insert(4, 40);
+    list = list.insert(2, 20);
+    list = list.insert(3, 30);
+
+    ASSERT_EQ(list.size(), 4u);
+    ASSERT_THAT(keys(list), ElementsAre(1, 2, 3, 4));
+    ASSERT_EQ(*list.find(3)->second, 30);
+}
+
+TEST(subscriber_list, erase_moves_back_inline)
+{
+    List list;
+
+    for (int i = 0; i < 4; ++i)
+    {
+        list = list.insert(i, i);
+    }
+
+    const auto shared = list;
+
+    list = list.erase(0);
+    list = list.erase(2);
+
+    ASSERT_THAT(keys(list), ElementsAre(1, 3));
+    ASSERT_THAT(keys(shared), ElementsAre(0, 1, 2, 3));
+}
+
+TEST(subscriber_list, erase_missing_key)
+{
+    List list;
+
+    list = list.insert(1, 10);
+    list = list.erase(2);
+
+    ASSERT_THAT(keys(list), ElementsAre(1));
+    ASSERT_EQ(list.find(2), list.end());
+
+    list = list.erase(1);
+
+    ASSERT_TRUE(list.empty());
+    ASSERT_EQ(list.begin(), list.end());
+}
+
+TEST(subscriber_list, appends_share_the_buffer)
+{
+    List list;
+
+    for (int i = 0; i < 3; ++i)
+    {
+        list = list.insert(i, i);
+    }
+
+    const auto first = list.insert(3, 30);
+    const auto second = first.insert(4, 40);
+
+    // The second append used the free space after the first one.
+    ASSERT_EQ(first.begin(), second.begin());
+
+    // Another version appending after the first one has to copy.
+    const auto other = first.insert(5, 50);
+
+    ASSERT_NE(other.begin(), first.begin());
+    ASSERT_THAT(keys(first), ElementsAre(0, 1, 2, 3));
+    ASSERT_THAT(keys(second), ElementsAre(0, 1, 2, 3, 4));
+    ASSERT_THAT(keys(other), ElementsAre(0, 1, 2, 3, 5));
+    ASSERT_EQ(*other.find(5)->second, 50);
+}
+
+TEST(subscriber_list, copies_share_callbacks)
+{
+    List list;
+
+    for (int i = 0; i < 5; ++i)
+    {
+        list = list.insert(i, i);
+    }
+
+    const auto erased = list.erase(1);
+    const auto inserted = erased.insert(1, 10);
+
+    ASSERT_THAT(keys(inserted), ElementsAre(0, 1, 2, 3, 4));
+    ASSERT_EQ(list.find(4)->second, erased.find(4)->second);
+    ASSERT_EQ(list.find(4)->second, inserted.find(4)->second);
+    ASSERT_EQ(*inserted.find(1)->second, 10);
+}
@@ -0,0 +1,153 @@
+#include "foundation/taskgraph.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+using namespace foundation;
+using namespace testing;
+
+TEST(task_graph, executes_every_node_once)
+{
+    TaskGraph graph;
+    std::atomic<int> counter(0);
+
+    for (auto i = 0; i < 100; ++i)
+    {
+        graph.add_node([&counter]() { counter.fetch_add(1); });
+    }
+
+    graph.execute();
+
+    ASSERT_EQ(counter.load(), 100);
+}
+
+TEST(task_graph, respects_dependencies)
+{
+    TaskGraph graph;
+
+    std::mutex mutex;
+    std::vector<TaskGraph::NodeId> order;
+
+    auto record = [&](TaskGraph::NodeId id)
+    {
+        return [&, id]()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(id);
+        };
+    };
+
+    // 0 -> 1 -> 3
+    // 0 -> 2 -> 3
+    auto a = graph.add_node(record(0));
+    auto b = graph.add_node(record(1));
+    auto c = graph.add_node(record(2));
+    auto d = graph.add_node(record(3));
+
+    graph.add_dependency(b, a);
+    graph.add_dependency(c, a);
+    graph.add_dependency(d, b);
+    graph.add_dependency(d, c);
+
+    graph.execute();
+
+    ASSERT_EQ(order.size(), 4u);
+    ASSERT_EQ(order.front(), a);
+    ASSERT_EQ(order.back(), d);
+}
+
+TEST(task_graph, executes_only_dirty_nodes)
+{
+    TaskGraph graph;
+    std::vector<std::atomic<int>> runs(4);
+
+    for (auto& r : runs)
+    {
+        r.store(0);
+    }
+
+    // 0 -> 1 -> 2, 3 is independent.
+    for (std::size_t i = 0; i < runs.size(); ++i)
+    {
+        graph.add_node([&runs, i]() { runs[i].fetch_add(1); });
+    }
+
+    graph.add_dependency(1, 0);
+    graph.add_dependency(2, 1);
+
+    graph.execute();
+
+    for (std::size_t i = 0; i < runs.size(); ++i)
+    {
+        ASSERT_FALSE(graph.is_dirty(i));
+    }
+
+    graph.mark_dirty(1);
+
+    ASSERT_FALSE(graph.is_dirty(0));
+    ASSERT_TRUE(graph.is_dirty(1));
+    ASSERT_TRUE(graph.is_dirty(2));
+    ASSERT_FALSE(graph.is_dirty(3));
+
+    graph.execute();
+
+    ASSERT_EQ(runs[0].load(), 1);
+    ASSERT_EQ(runs[1].load(), 2);
+    ASSERT_EQ(runs[2].load(), 2);
+    ASSERT_EQ(runs[3].load(), 1);
+}
+
+TEST(task_graph, exception_keeps_downstream_dirty)
+{
+    TaskGraph graph;
+    bool should_throw = true;
+
+    auto a = graph.add_node([&should_throw]()
+        {
+            if (should_throw)
+            {
+                throw std::runtime_error("failure");
+            }
+        });
+
+    auto b = graph.add_node([]() {});
+    graph.add_dependency(b, a);
+
+    ASSERT_THROW(graph.execute(), std::runtime_error);
+    ASSERT_TRUE(graph.is_dirty(a));
+    ASSERT_TRUE(graph.is_dirty(b));
+
+    should_throw = false;
+    graph.execute();
+
+    ASSERT_FALSE(graph.is_dirty(a));
+    ASSERT_FALSE(graph.is_dirty(b));
+}
+
+TEST(task_graph, detects_cycle)
+{
+    TaskGraph graph;
+
+    auto a = graph.add_node([]() {});
+    auto b = graph.add_node([]() {});
+
+    graph.add_dependency(b, a);
+    graph.add_dependency(a, b);
+
+    ASSERT_THROW(graph.execute(), std::logic_error);
+}
+
+TEST(task_graph, invalid_node_id)
+{
+    TaskGraph graph;
+    auto a = graph.add_node([]() {});
+
+    ASSERT_THROW(graph.add_dependency(a, a + 1), std::out_of_range);
+    ASSERT_THROW(graph.mark_dirty(a + 1), std::out_of_range);
+}
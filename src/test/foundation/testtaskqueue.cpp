@@ -6,10 +6,12 @@
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <thread>
 #include <utility>
+#include <vector>
 
 using namespace foundation;
 using namespace testing;
@@ -112,3 +114,250 @@ TEST(task_queue, test_post_when_queue_is_busy)
             return ready.load();
         });
 }
+
+TEST(task_queue, test_drain_waits_for_posted_tasks)
+{
+    TaskQueue queue;
+    std::atomic<int> counter(0);
+
+    constexpr auto ntasks = 1000;
+    for (auto i = 0; i < ntasks; ++i)
+    {
+        queue.post([&counter]()
+            {
+                counter.fetch_add(1);
+            });
+    }
+
+    queue.drain();
+
+    ASSERT_EQ(counter.load(), ntasks);
+}
+
+TEST(task_queue, test_drain_on_idle_queue)
+{
+    TaskQueue queue;
+    queue.drain();
+}
+
+TEST(task_queue, test_shutdown_rejects_new_tasks)
+{
+    TaskQueue queue;
+    std::atomic<int> counter(0);
+
+    ASSERT_TRUE(queue.post([&counter]()
+        {
+            counter.fetch_add(1);
+        }));
+
+    ASSERT_TRUE(queue.shutdown(std::chrono::seconds(10)));
+    ASSERT_EQ(counter.load(), 1);
+
+    ASSERT_FALSE(queue.post([&counter]()
+        {
+            counter.fetch_add(1);
+        }));
+
+    queue.drain();
+    ASSERT_EQ(counter.load(), 1);
+}
+
+TEST(task_queue, test_shutdown_timeout_discards_pending_tasks)
+{
+    TaskQueue queue;
+    std::atomic<int> counter(0);
+
+    constexpr auto ntasks = 10;
+    for (auto i = 0; i < ntasks; ++i)
+    {
+        queue.post([&counter]()
+            {
+                std::this_thread::sleep_for(50ms);
+                counter.fetch_add(1);
+            });
+    }
+
+    ASSERT_FALSE(queue.shutdown(10ms));
+
+    queue.drain();
+    ASSERT_LT(counter.load(), ntasks);
+}
+
+TEST(task_queue, stress_destroy_while_tasks_in_flight)
+{
+    constexpr auto nqueues = 64;
+    constexpr auto ntasks = 2000;
+
+    // Cleared once the queue is destroyed, no task may run after that.
+    struct QueueState
+    {
+        std::atomic<bool>   is_alive {true};
+        std::atomic<int>    executed_count {0};
+    };
+
+    auto late_tasks_count = std::make_shared<std::atomic<int>>(0);
+    std::vector<std::shared_ptr<QueueState>> states;
+
+    for (auto round = 0; round < 8; ++round)
+    {
+        std::vector<std::unique_ptr<TaskQueue>> queues;
+        std::vector<std::shared_ptr<QueueState>> round_states;
+
+        for (auto i = 0; i < nqueues; ++i)
+        {
+            queues.push_back(std::make_unique<TaskQueue>());
+            round_states.push_back(std::make_shared<QueueState>());
+        }
+
+        std::vector<std::thread> producers;
+        for (auto i = 0; i < nqueues; ++i)
+        {
+            producers.emplace_back([&queue = queues[i], state = round_states[i], late_tasks_count]()
+                {
+                    for (auto j = 0; j < ntasks; ++j)
+                    {
+                        queue->post([state, late_tasks_count]()
+                            {
+                                if (!state->is_alive.load())
+                                {
+                                    late_tasks_count->fetch_add(1);
+                                }
+
+                                state->executed_count.fetch_add(1);
+                            });
+                    }
+                });
+        }
+
+        for (auto& producer : producers)
+        {
+            producer.join();
+        }
+
+        // Destroy the queues while most of the tasks are still pending.
+        for (auto i = 0; i < nqueues; ++i)
+        {
+            queues[i].reset();
+            round_states[i]->is_alive.store(false);
+        }
+
+        states.insert(states.end(), round_states.begin(), round_states.end());
+    }
+
+    // Give the tasks wrongly left running a chance to show up.
+    std::this_thread::sleep_for(50ms);
+
+    ASSERT_EQ(late_tasks_count->load(), 0);
+
+    for (const auto& state : states)
+    {
+        ASSERT_LE(state->executed_count.load(), ntasks);
+    }
+}
+
+TEST(task_queue, test_statistics_disabled_by_default)
+{
+    TaskQueue queue;
+
+    queue.post([]() {});
+    queue.drain();
+
+    auto stats = queue.statistics();
+
+    ASSERT_EQ(stats.executed_count, 0u);
+    ASSERT_EQ(stats.wait_time.count(), 0u);
+    ASSERT_EQ(stats.depth, 0u);
+}
+
+TEST(task_queue, test_statistics)
+{
+    TaskQueue queue;
+    queue.enable_statistics(true);
+
+    constexpr auto ntasks = 100;
+    for (auto i = 0; i < ntasks; ++i)
+    {
+        queue.post([]()
+            {
+                std::this_thread::sleep_for(10us);
+            });
+    }
+
+    queue.drain();
+
+    auto stats = queue.statistics();
+
+    ASSERT_EQ(stats.executed_count, static_cast<std::uint64_t>(ntasks));
+    ASSERT_EQ(stats.wait_time.count(), static_cast<std::uint64_t>(ntasks));
+    ASSERT_EQ(stats.execution_time.count(), static_cast<std::uint64_t>(ntasks));
+    ASSERT_GE(stats.execution_time.percentile(0.5), 10000u);
+    ASSERT_GE(stats.max_depth, 1u);
+    ASSERT_EQ(stats.depth, 0u);
+    ASSERT_GT(stats.tasks_per_second, 0.0);
+
+    queue.reset_statistics();
+    stats = queue.statistics();
+
+    ASSERT_EQ(stats.executed_count, 0u);
+    ASSERT_EQ(stats.max_depth, 0u);
+}
+
+TEST(task_queue, test_post_delayed)
+{
+    TaskQueue queue;
+
+    std::mutex mutex;
+    std::vector<int> order;
+
+    const auto record = [&mutex, &order](int i)
+    {
+        return [&mutex, &order, i]()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(i);
+        };
+    };
+
+    const auto start = std::chrono::steady_clock::now();
+
+    queue.post_delayed(record(3), 60ms);
+    queue.post_delayed(record(2), 30ms);
+    queue.post_delayed(record(0), 0ms);
+    queue.post(record(1));
+
+    std::this_thread::sleep_for(150ms);
+    queue.drain();
+
+    ASSERT_THAT(order, ElementsAre(0, 1, 2, 3));
+    ASSERT_GE(std::chrono::steady_clock::now() - start, 60ms);
+}
+
+TEST(task_queue, test_post_delayed_discarded_with_queue)
+{
+    std::atomic<bool> executed(false);
+
+    {
+        TaskQueue queue;
+        queue.post_delayed([&executed]() { executed = true; }, 50ms);
+    }
+
+    std::this_thread::sleep_for(100ms);
+    ASSERT_FALSE(executed);
+}
+
+TEST(task_queue, test_post_delayed_after_shutdown)
+{
+    std::atomic<bool> executed(false);
+
+    TaskQueue queue;
+
+    ASSERT_TRUE(queue.post_delayed([&executed]() { executed = true; }, 50ms));
+    ASSERT_TRUE(queue.shutdown(std::chrono::seconds(10)));
+
+    ASSERT_FALSE(queue.post_delayed([&executed]() { executed = true; }, 10ms));
+    ASSERT_FALSE(queue.post_delayed([&executed]() { executed = true; }, 0ms));
+
+    // Due after the shutdown.
+    std::this_thread::sleep_for(100ms);
+    ASSERT_FALSE(executed);
+}
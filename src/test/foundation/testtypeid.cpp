@@ -0,0 +1,117 @@
+#include "foundation/sharedany.h"
+#include "foundation/typeid.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace foundation;
+
+// Defined in testtypeidother.cpp.
+TypeId other_node_type_id();
+TypeId other_node_unique_type_id();
+immutable::SharedAny make_other_node();
+
+namespace
+{
+
+struct Node {};
+
+template <typename T>
+struct Wrapper {};
+
+} // namespace
+
+TEST(type_id, is_constant)
+{
+    static_assert(type_id<int> == type_id<int>);
+    static_assert(type_id<int> != type_id<unsigned>);
+    static_assert(type_id<Node> != type_id<Node*>);
+
+    constexpr TypeId id = type_id<std::string>;
+    ASSERT_EQ(id, type_id<std::string>);
+}
+
+TEST(type_id, ignores_references_and_cv)
+{
+    static_assert(type_id<const int> == type_id<int>);
+    static_assert(type_id<volatile int&> == type_id<int>);
+    static_assert(type_id<const Node&&> == type_id<Node>);
+
+    // Only top level qualifiers are ignored.
+    static_assert(type_id<const int*> != type_id<int*>);
+}
+
+TEST(type_id, aliases_name_the_same_type)
+{
+    using Alias = std::int64_t;
+
+    static_assert(type_id<Alias> == type_id<std::int64_t>);
+    static_assert(type_id<std::vector<Alias>> == type_id<std::vector<std::int64_t>>);
+}
+
+TEST(type_id, distinct_types)
+{
+    const std::vector<TypeId> ids {
+        type_id<char>,
+        type_id<std::int8_t>,
+        type_id<std::uint8_t>,
+        type_id<std::int16_t>,
+        type_id<std::uint16_t>,
+        type_id<std::int32_t>,
+        type_id<std::uint32_t>,
+        type_id<std::int64_t>,
+        type_id<std::uint64_t>,
+        type_id<float>,
+        type_id<double>,
+        type_id<char*>,
+        type_id<std::string>,
+        type_id<Node>,
+        type_id<Wrapper<int>>,
+        type_id<Wrapper<Node>>,
+        type_id<std::shared_ptr<Node>>};
+
+    for (std::size_t i = 0; i < ids.size(); ++i)
+    {
+        for (std::size_t j = i + 1; j < ids.size(); ++j)
+        {
+            ASSERT_NE(ids[i], ids[j]) << i << ", " << j;
+        }
+    }
+}
+
+TEST(type_id, anonymous_types_of_other_translation_units)
+{
+    // Both anonymous namespaces are spelled the same in the type name.
+    ASSERT_EQ(type_id<Node>, other_node_type_id());
+    ASSERT_NE(unique_type_id<Node>(), other_node_unique_type_id());
+    ASSERT_EQ(unique_type_id<Node>(), unique_type_id<const Node&>());
+
+    const auto other = make_other_node();
+
+    ASSERT_FALSE(other.pure_is<Node>());
+    ASSERT_EQ(other.get<Node>(), nullptr);
+    ASSERT_THROW(other.pure_cast<Node>(), std::bad_cast);
+    ASSERT_THROW(other.value<Node>(), std::bad_cast);
+
+    const immutable::SharedAny node(Node {});
+    ASSERT_TRUE(node.pure_is<Node>());
+}
+
+TEST(type_id, anonymous_types)
+{
+    static_assert(is_anonymous_type<Node>);
+    static_assert(is_anonymous_type<const Node*>);
+    static_assert(is_anonymous_type<std::vector<Wrapper<int>>>);
+    static_assert(!is_anonymous_type<int>);
+    static_assert(!is_anonymous_type<std::string>);
+    static_assert(!is_anonymous_type<std::vector<std::string>>);
+
+    // Other types keep their compile time identifier.
+    static_assert(unique_type_id<std::string>() == type_id<std::string>);
+}
@@ -0,0 +1,33 @@
+#include "foundation/sharedany.h"
+#include "foundation/typeid.h"
+
+#include <string>
+
+using namespace foundation;
+
+// A type of the same name as in testtypeid.cpp, with another layout.
+
+namespace
+{
+
+struct Node
+{
+    std::string name;
+};
+
+} // namespace
+
+TypeId other_node_type_id()
+{
+    return type_id<Node>;
+}
+
+TypeId other_node_unique_type_id()
+{
+    return unique_type_id<Node>();
+}
+
+immutable::SharedAny make_other_node()
+{
+    return immutable::SharedAny(Node {"other"});
+}
@@ -1,5 +1,10 @@
 #include "foundation/vector.h"
 
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -144,3 +149,201 @@ TEST(vector3, cross_product)
 
     ASSERT_EQ(c, cp);
 }
+
+TEST(vector3, matches_generic_implementation)
+{
+    Vector3f a(1.5f, -2.25f, 7.0f);
+    Vector3f b(3.0f, -4.5f, 0.125f);
+
+    ASSERT_EQ((operator+<3, float>(a, b)), a + b);
+    ASSERT_EQ((operator-<3, float>(a, b)), a - b);
+    ASSERT_EQ((operator*<3, float>(a, 3.0f)), a * 3.0f);
+    ASSERT_EQ((dot_product<3, float>(a, b)), dot_product(a, b));
+    ASSERT_EQ((multiply_add<3, float>(a, 3.0f, b)), multiply_add(a, 3.0f, b));
+    ASSERT_EQ((multiply_add<3, float>(a, b, a)), multiply_add(a, b, a));
+    ASSERT_EQ((cross_product<float>(a, b)), cross_product(a, b));
+}
+
+TEST(vector3, scalar_mult_by_infinity)
+{
+    Vector3f a(1.0f, 1.0f, 2.0f);
+    const float inf = std::numeric_limits<float>::infinity();
+
+    auto res = a * inf;
+
+    ASSERT_EQ(res, Vector3f(inf, inf, inf));
+    ASSERT_EQ(dot_product(res, res), inf);
+}
+
+//
+// Vector4 tests
+//
+
+TEST(vector4, add)
+{
+    Vector4f a(0.0f, 1.0f, 4.0f, -1.0f);
+    Vector4f b(2.0f, 3.0f, 5.0f, 2.0f);
+
+    auto res = Vector4f {2.0f, 4.0f, 9.0f, 1.0f};
+
+    ASSERT_EQ(res, a + b);
+}
+
+TEST(vector4, sub)
+{
+    Vector4f a(0.0f, 1.0f, 4.0f, -1.0f);
+    Vector4f b(2.0f, 3.0f, 5.0f, 2.0f);
+
+    auto res = Vector4f {-2.0f, -2.0f, -1.0f, -3.0f};
+
+    ASSERT_EQ(res, a - b);
+}
+
+TEST(vector4, scalar_mult)
+{
+    Vector4f a(2.0f, 1.0f, 4.0f, -1.0f);
+    float factor = 5.0f;
+
+    auto res = Vector4f {10.0f, 5.0f, 20.0f, -5.0f};
+
+    ASSERT_EQ(res, a * factor);
+}
+
+TEST(vector4, unary_minus)
+{
+    Vector4f a(1.0f, -1.0f, 0.0f, 2.0f);
+
+    auto res = Vector4f {-1.0f, 1.0f, -0.0f, -2.0f};
+
+    ASSERT_EQ(res, -a);
+}
+
+TEST(vector4, equals)
+{
+    Vector4f a(1.0f, 2.0f, 3.0f, 4.0f);
+    Vector4f b(1.0f, 2.0f, 3.0f, 4.0f);
+    Vector4f c(1.0f, 2.0f, 3.0f, -4.0f);
+
+    ASSERT_TRUE(a == b);
+    ASSERT_TRUE(!(a == c));
+    ASSERT_TRUE(a != c);
+    ASSERT_TRUE(!(a != b));
+}
+
+TEST(vector4, dot_product)
+{
+    Vector4f a(1.0f, 2.0f, 7.0f, 2.0f);
+    Vector4f b(3.0f, -4.0f, 6.0f, 0.5f);
+
+    auto dp = dot_product(a, b);
+
+    ASSERT_EQ(38.0f, dp);
+}
+
+TEST(vector4, matches_generic_implementation)
+{
+    Vector4f a(1.5f, -2.25f, 7.0f, 0.5f);
+    Vector4f b(3.0f, -4.5f, 0.125f, -8.0f);
+
+    ASSERT_EQ((operator+<4, float>(a, b)), a + b);
+    ASSERT_EQ((operator-<4, float>(a, b)), a - b);
+    ASSERT_EQ((operator*<4, float>(a, 3.0f)), a * 3.0f);
+    ASSERT_EQ((dot_product<4, float>(a, b)), dot_product(a, b));
+    ASSERT_EQ((multiply_add<4, float>(a, 3.0f, b)), multiply_add(a, 3.0f, b));
+    ASSERT_EQ((multiply_add<4, float>(a, b, a)), multiply_add(a, b, a));
+}
+
+//
+// Fused operations
+//
+
+TEST(vector3, multiply_add)
+{
+    Vector3f a(1.0f, 2.0f, 3.0f);
+    Vector3f b(2.0f, 0.5f, -1.0f);
+    Vector3f c(1.0f, 1.0f, 1.0f);
+
+    ASSERT_EQ(a * 2.0f + c, multiply_add(a, 2.0f, c));
+    ASSERT_EQ(Vector3f(3.0f, 2.0f, -2.0f), multiply_add(a, b, c));
+}
+
+//
+// Compile time vectors
+//
+
+namespace
+{
+
+constexpr std::array<Vector3f, 8> unit_cube_corners {
+    Vector3f(-0.5f, -0.5f, -0.5f),
+    Vector3f( 0.5f, -0.5f, -0.5f),
+    Vector3f(-0.5f,  0.5f, -0.5f),
+    Vector3f( 0.5f,  0.5f, -0.5f),
+    Vector3f(-0.5f, -0.5f,  0.5f),
+    Vector3f( 0.5f, -0.5f,  0.5f),
+    Vector3f(-0.5f,  0.5f,  0.5f),
+    Vector3f( 0.5f,  0.5f,  0.5f)};
+
+constexpr Vector3f corners_sum()
+{
+    Vector3f sum(0.0f, 0.0f, 0.0f);
+    for (const auto& corner : unit_cube_corners)
+    {
+        sum = sum + corner;
+    }
+    return sum;
+}
+
+// Scaled and moved copy of the cube, built at compile time.
+constexpr std::array<Vector3f, 2> gizmo_box {
+    multiply_add(unit_cube_corners[0], 2.0f, Vector3f(0.0f, 0.0f, 1.0f)),
+    multiply_add(unit_cube_corners[7], 2.0f, Vector3f(0.0f, 0.0f, 1.0f))};
+
+} // namespace
+
+TEST(vector3, constexpr_operations)
+{
+    constexpr Vector3f x(1.0f, 0.0f, 0.0f);
+    constexpr Vector3f y(0.0f, 1.0f, 0.0f);
+
+    static_assert(cross_product(x, y) == Vector3f(0.0f, 0.0f, 1.0f));
+    static_assert(dot_product(x + y, x - y) == 0.0f);
+    static_assert(-x * 2.0f == Vector3f(-2.0f, 0.0f, 0.0f));
+    static_assert(corners_sum() == Vector3f(0.0f, 0.0f, 0.0f));
+    static_assert(gizmo_box[0] == Vector3f(-1.0f, -1.0f, 0.0f));
+    static_assert(gizmo_box[1].z() == 2.0f);
+
+    // Same results at run time.
+    auto runtime_x = x;
+    ASSERT_EQ(cross_product(x, y), cross_product(runtime_x, y));
+    ASSERT_EQ(gizmo_box[1], multiply_add(unit_cube_corners[7], 2.0f, Vector3f(0.0f, 0.0f, 1.0f)));
+}
+
+TEST(vector4, constexpr_operations)
+{
+    constexpr Vector4f a(1.0f, 2.0f, 3.0f, 1.0f);
+    constexpr Vector4f b(0.5f, 0.5f, 0.5f, 0.0f);
+
+    static_assert(a + b == Vector4f(1.5f, 2.5f, 3.5f, 1.0f));
+    static_assert(a - b != a);
+    static_assert(dot_product(a, b) == 3.0f);
+    static_assert(multiply_add(a, b, b) == Vector4f(1.0f, 1.5f, 2.0f, 0.0f));
+    static_assert(multiply_add(b, 2.0f, a).w() == 1.0f);
+}
+
+TEST(vector, constexpr_generic_dimensions)
+{
+    constexpr auto v = []
+    {
+        Vector<5, double> res;
+        for (std::size_t i = 0; i < 5; ++i)
+        {
+            res[i] = static_cast<double>(i);
+        }
+        return res;
+    }();
+
+    static_assert(dot_product(v, v) == 30.0);
+    static_assert((-v)[4] == -4.0);
+    static_assert(multiply_add(v, 2.0, v)[2] == 6.0);
+}
@@ -0,0 +1,177 @@
+#include "foundation/vectorstream.h"
+
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace foundation;
+
+namespace
+{
+
+// Not a multiple of four, so both the SIMD and the scalar paths run.
+std::vector<Vector3f> make_points(std::size_t count, float offset)
+{
+    std::vector<Vector3f> result;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const auto f = static_cast<float>(i);
+        result.emplace_back(f + offset, 2.0f * f - offset, 1.0f - f * offset);
+    }
+
+    return result;
+}
+
+void expect_near(const Vector3f& expected, const Vector3f& actual)
+{
+    EXPECT_NEAR(expected.x(), actual.x(), 1e-4f * (1.0f + std::abs(expected.x())));
+    EXPECT_NEAR(expected.y(), actual.y(), 1e-4f * (1.0f + std::abs(expected.y())));
+    EXPECT_NEAR(expected.z(), actual.z(), 1e-4f * (1.0f + std::abs(expected.z())));
+}
+
+} // namespace
+
+TEST(vector_stream, round_trips_vectors)
+{
+    const auto points = make_points(11, 0.5f);
+
+    VectorStream3f stream(points);
+
+    ASSERT_EQ(points.size(), stream.size());
+    ASSERT_EQ(points, stream.to_vector());
+
+    ASSERT_EQ(points[3].y(), stream.component(1)[3]);
+}
+
+TEST(vector_stream, push_back_set_and_resize)
+{
+    VectorStream3f stream;
+    stream.push_back(Vector3f(1.0f, 2.0f, 3.0f));
+    stream.push_back(Vector3f(4.0f, 5.0f, 6.0f));
+
+    stream.set(0, Vector3f(7.0f, 8.0f, 9.0f));
+    stream.resize(3);
+
+    ASSERT_EQ(3u, stream.size());
+    ASSERT_EQ(Vector3f(7.0f, 8.0f, 9.0f), stream.get(0));
+    ASSERT_EQ(Vector3f(4.0f, 5.0f, 6.0f), stream.get(1));
+    ASSERT_EQ(Vector3f(0.0f, 0.0f, 0.0f), stream.get(2));
+}
+
+TEST(vector_stream, add_sub_and_scale)
+{
+    const auto a = make_points(11, 0.5f);
+    const auto b = make_points(11, -1.5f);
+
+    VectorStream3f sum;
+    add(VectorStream3f(a), VectorStream3f(b), sum);
+
+    VectorStream3f difference;
+    sub(VectorStream3f(a), VectorStream3f(b), difference);
+
+    VectorStream3f scaled;
+    scale(VectorStream3f(a), 3.0f, scaled);
+
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        ASSERT_EQ(a[i] + b[i], sum.get(i));
+        ASSERT_EQ(a[i] - b[i], difference.get(i));
+        ASSERT_EQ(a[i] * 3.0f, scaled.get(i));
+    }
+}
+
+TEST(vector_stream, dot_and_cross_product)
+{
+    const auto a = make_points(11, 0.5f);
+    const auto b = make_points(11, -1.5f);
+
+    std::vector<float> dots;
+    dot_product(VectorStream3f(a), VectorStream3f(b), dots);
+
+    VectorStream3f crosses;
+    cross_product(VectorStream3f(a), VectorStream3f(b), crosses);
+
+    ASSERT_EQ(a.size(), dots.size());
+
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        ASSERT_FLOAT_EQ(dot_product(a[i], b[i]), dots[i]);
+        expect_near(cross_product(a[i], b[i]), crosses.get(i));
+    }
+}
+
+TEST(vector_stream, normalize)
+{
+    const auto a = make_points(11, 0.5f);
+
+    VectorStream3f normalized;
+    normalize(VectorStream3f(a), normalized);
+
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        const auto n = normalized.get(i);
+
+        ASSERT_NEAR(1.0f, dot_product(n, n), 1e-5f);
+        expect_near(a[i] * (1.0f / std::sqrt(dot_product(a[i], a[i]))), n);
+    }
+}
+
+TEST(vector_stream, transform_in_place)
+{
+    const auto a = make_points(11, 0.5f);
+
+    const std::array<Vector3f, 3> rows {
+        Vector3f(0.0f, -1.0f, 0.0f),
+        Vector3f(1.0f, 0.0f, 0.0f),
+        Vector3f(0.0f, 0.0f, 2.0f)};
+
+    const Vector3f translation(1.0f, 2.0f, 3.0f);
+
+    VectorStream3f stream(a);
+    transform(stream, rows, translation, stream);
+
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        const Vector3f expected(
+            dot_product(rows[0], a[i]) + translation.x(),
+            dot_product(rows[1], a[i]) + translation.y(),
+            dot_product(rows[2], a[i]) + translation.z());
+
+        expect_near(expected, stream.get(i));
+    }
+}
+
+TEST(vector_stream, generic_dimensions)
+{
+    Vector<5, double> v;
+
+    for (std::size_t d = 0; d < 5; ++d)
+    {
+        v[d] = static_cast<double>(d);
+    }
+
+    VectorStream<5, double> stream(std::vector<Vector<5, double>>(3, v));
+
+    VectorStream<5, double> doubled;
+    add(stream, stream, doubled);
+
+    std::vector<double> dots;
+    dot_product(stream, stream, dots);
+
+    ASSERT_EQ(v * 2.0, doubled.get(2));
+    ASSERT_EQ(std::vector<double>(3, 30.0), dots);
+}
+
+TEST(vector_stream, throws_on_size_mismatch)
+{
+    VectorStream3f a(3);
+    VectorStream3f b(4);
+    VectorStream3f out;
+
+    ASSERT_THROW(add(a, b, out), std::invalid_argument);
+}